@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include "Benchmark.hpp"
+
+namespace psychic_ui {
+    namespace benchmark {
+
+        // region Samples
+
+        Samples::Samples(std::string name) :
+            _name(std::move(name)) {}
+
+        const std::string &Samples::name() const {
+            return _name;
+        }
+
+        void Samples::add(const double value) {
+            _values.push_back(value);
+        }
+
+        double Samples::mean() const {
+            if (_values.empty()) {
+                return 0.0;
+            }
+            return std::accumulate(_values.cbegin(), _values.cend(), 0.0) / _values.size();
+        }
+
+        double Samples::min() const {
+            return _values.empty() ? 0.0 : *std::min_element(_values.cbegin(), _values.cend());
+        }
+
+        double Samples::max() const {
+            return _values.empty() ? 0.0 : *std::max_element(_values.cbegin(), _values.cend());
+        }
+
+        double Samples::percentile(const double percent) const {
+            if (_values.empty()) {
+                return 0.0;
+            }
+            std::vector<double> sorted(_values);
+            std::sort(sorted.begin(), sorted.end());
+            auto rank = static_cast<size_t>(std::ceil(percent / 100.0 * sorted.size()));
+            return sorted[std::min(std::max(rank, static_cast<size_t>(1)), sorted.size()) - 1];
+        }
+
+        // endregion
+
+        // region Reports
+
+        void report(std::ostream &out, const std::vector<Result> &results) {
+            out << std::fixed << std::setprecision(3);
+            for (const auto &result: results) {
+                out << result.scene << " (" << result.divs << " divs)" << std::endl;
+                out << "    " << std::left << std::setw(16) << "phase" << std::right
+                    << std::setw(10) << "mean"
+                    << std::setw(10) << "p50"
+                    << std::setw(10) << "p90"
+                    << std::setw(10) << "p99"
+                    << std::setw(10) << "max"
+                    << "  (ms)" << std::endl;
+                for (const auto &phase: result.phases) {
+                    out << "    " << std::left << std::setw(16) << phase.name() << std::right
+                        << std::setw(10) << phase.mean()
+                        << std::setw(10) << phase.percentile(50)
+                        << std::setw(10) << phase.percentile(90)
+                        << std::setw(10) << phase.percentile(99)
+                        << std::setw(10) << phase.max()
+                        << std::endl;
+                }
+                out << std::endl;
+            }
+        }
+
+        void reportJSON(std::ostream &out, const Options &options, const std::vector<Result> &results) {
+            out << std::fixed << std::setprecision(6);
+            out << "{" << std::endl;
+            out << "  \"version\": 1," << std::endl;
+            out << "  \"iterations\": " << options.iterations << "," << std::endl;
+            out << "  \"width\": " << options.width << "," << std::endl;
+            out << "  \"height\": " << options.height << "," << std::endl;
+            out << "  \"scenes\": [";
+            for (size_t i = 0; i < results.size(); ++i) {
+                const auto &result = results[i];
+                out << (i > 0 ? "," : "") << std::endl;
+                out << "    {" << std::endl;
+                out << "      \"name\": \"" << result.scene << "\"," << std::endl;
+                out << "      \"divs\": " << result.divs << "," << std::endl;
+                out << "      \"phases\": {";
+                for (size_t j = 0; j < result.phases.size(); ++j) {
+                    const auto &phase = result.phases[j];
+                    out << (j > 0 ? "," : "") << std::endl;
+                    out << "        \"" << phase.name() << "\": {"
+                        << "\"mean\": " << phase.mean()
+                        << ", \"min\": " << phase.min()
+                        << ", \"p50\": " << phase.percentile(50)
+                        << ", \"p90\": " << phase.percentile(90)
+                        << ", \"p99\": " << phase.percentile(99)
+                        << ", \"max\": " << phase.max()
+                        << "}";
+                }
+                out << std::endl << "      }" << std::endl;
+                out << "    }";
+            }
+            out << std::endl << "  ]" << std::endl;
+            out << "}" << std::endl;
+        }
+
+        // endregion
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <psychic-ui/Window.hpp>
+#include <psychic-ui/applications/HeadlessApplication.hpp>
+
+namespace psychic_ui {
+    namespace benchmark {
+
+        /**
+         * Benchmark run options, from the command line
+         */
+        struct Options {
+            unsigned int iterations{200};
+            unsigned int warmup{10};
+            int          width{1440};
+            int          height{900};
+            std::string  filter{};
+            std::string  json{};
+        };
+
+        /**
+         * Timings of a single frame phase, in milliseconds
+         */
+        class Samples {
+        public:
+            explicit Samples(std::string name);
+
+            const std::string &name() const;
+            void add(double value);
+
+            double mean() const;
+            double min() const;
+            double max() const;
+
+            /**
+             * Nearest-rank percentile
+             * @param percent Percentile, between 0 and 100
+             */
+            double percentile(double percent) const;
+
+        protected:
+            std::string         _name;
+            std::vector<double> _values{};
+        };
+
+        /**
+         * Timings of every phase of a scene
+         */
+        struct Result {
+            std::string          scene;
+            unsigned int         divs{0};
+            std::vector<Samples> phases{};
+        };
+
+        /**
+         * Wraps a window in order to drive its frame phases one by one
+         * Style, layout computation, layout propagation and rendering are timed
+         * separately. Every iteration invalidates the whole tree so that each phase
+         * does its full amount of work instead of hitting the incremental paths.
+         * @tparam T :Window
+         */
+        template<typename T>
+        class Benchmarked : public T {
+        public:
+            using T::T;
+
+            Result measure(const std::string &scene, const Options &options) {
+                Result result{scene, countDivs(this), {
+                    Samples("style"),
+                    Samples("layout"),
+                    Samples("layoutUpdated"),
+                    Samples("render"),
+                    Samples("frame")
+                }};
+
+                for (unsigned int i = 0; i < options.warmup + options.iterations; ++i) {
+                    // Alternate the width so that yoga has to compute everything again
+                    YGNodeStyleSetWidth(this->_yogaNode, options.width - (i % 2));
+                    this->invalidateStyle();
+
+                    auto start = std::chrono::high_resolution_clock::now();
+                    this->updateStyleRecursive();
+                    auto styled = std::chrono::high_resolution_clock::now();
+                    this->calculateLayout();
+                    auto calculated = std::chrono::high_resolution_clock::now();
+                    this->layoutUpdated();
+                    auto laidOut = std::chrono::high_resolution_clock::now();
+                    this->renderFrame();
+                    auto rendered = std::chrono::high_resolution_clock::now();
+
+                    if (i < options.warmup) {
+                        continue;
+                    }
+
+                    result.phases[0].add(milliseconds(start, styled));
+                    result.phases[1].add(milliseconds(styled, calculated));
+                    result.phases[2].add(milliseconds(calculated, laidOut));
+                    result.phases[3].add(milliseconds(laidOut, rendered));
+                    result.phases[4].add(milliseconds(start, rendered));
+                }
+
+                return result;
+            }
+
+        protected:
+            static double milliseconds(
+                const std::chrono::high_resolution_clock::time_point &from,
+                const std::chrono::high_resolution_clock::time_point &to
+            ) {
+                return std::chrono::duration<double, std::milli>(to - from).count();
+            }
+
+            static unsigned int countDivs(const Div *div) {
+                unsigned int count = 1;
+                for (const auto &child: div->children()) {
+                    count += countDivs(child.get());
+                }
+                return count;
+            }
+        };
+
+        /**
+         * Named benchmark scene
+         */
+        struct Scene {
+            std::string                             name;
+            std::function<Result(const Options &)> run;
+        };
+
+        /**
+         * Create a scene from a window factory
+         * The window is opened in a headless application, sized and rendered once before being measured.
+         * @tparam T :Window
+         */
+        template<typename T>
+        Scene scene(const std::string &name, std::function<std::shared_ptr<Benchmarked<T>>()> create) {
+            return Scene{
+                name,
+                [name, create](const Options &options) {
+                    auto application = std::make_unique<HeadlessApplication>();
+                    application->init();
+                    auto window = create();
+                    application->open(window);
+                    window->setWindowSize(options.width, options.height);
+                    application->step();
+                    Result result = window->measure(name, options);
+                    application->close(window);
+                    application->shutdown();
+                    return result;
+                }
+            };
+        }
+
+        void report(std::ostream &out, const std::vector<Result> &results);
+        void reportJSON(std::ostream &out, const Options &options, const std::vector<Result> &results);
+    }
+}
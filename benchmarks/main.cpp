@@ -0,0 +1,120 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "example/demo/DemoWindow.hpp"
+#include "Benchmark.hpp"
+#include "scenes.hpp"
+
+using namespace psychic_ui;
+using namespace psychic_ui::benchmark;
+
+/**
+ * Window showing a single demo screen, the way the demo shows it in its tab container
+ * @tparam T :Div
+ */
+template<typename T>
+class DemoScreenWindow : public Window {
+public:
+    DemoScreenWindow() : Window("Demo Screen") {
+        loadStyleSheet<OneDarkStyleSheet>();
+        loadStyleSheet<DemoStyleSheet>();
+        app->add<T>()
+           ->style()
+           ->set(grow, 1);
+    }
+};
+
+/**
+ * Plain window with the default theme, filled by a scene builder
+ */
+class SceneWindow : public Window {
+public:
+    explicit SceneWindow(const std::function<void(Div *)> &build) : Window("Scene") {
+        loadStyleSheet<OneDarkStyleSheet>();
+        build(app.get());
+    }
+};
+
+template<typename T>
+static Scene demoScreen(const std::string &name) {
+    return scene<DemoScreenWindow<T>>(name, []() { return std::make_shared<Benchmarked<DemoScreenWindow<T>>>(); });
+}
+
+static Scene builtScene(const std::string &name, const std::function<void(Div *)> &build) {
+    return scene<SceneWindow>(name, [build]() { return std::make_shared<Benchmarked<SceneWindow>>(build); });
+}
+
+static void usage(const char *executable) {
+    std::cout << "Usage: " << executable << " [options]" << std::endl
+              << "    --iterations <n>  Measured frames per scene (default 200)" << std::endl
+              << "    --warmup <n>      Frames rendered before measuring (default 10)" << std::endl
+              << "    --size <w> <h>    Window size (default 1440 900)" << std::endl
+              << "    --filter <text>   Only run the scenes whose name contains the text" << std::endl
+              << "    --json <path>     Write the results as JSON, use - for stdout" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    Options options{};
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            options.iterations = static_cast<unsigned int>(std::stoul(argv[++i]));
+        } else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            options.warmup = static_cast<unsigned int>(std::stoul(argv[++i]));
+        } else if (std::strcmp(argv[i], "--size") == 0 && i + 2 < argc) {
+            options.width  = std::stoi(argv[++i]);
+            options.height = std::stoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            options.json = argv[++i];
+        } else {
+            usage(argv[0]);
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : -1;
+        }
+    }
+
+    std::vector<Scene> scenes{
+        scene<DemoWindow>("demo", []() { return std::make_shared<Benchmarked<DemoWindow>>(); }),
+        demoScreen<Divs>("demo/divs"),
+        demoScreen<Scrollers>("demo/scrollers"),
+        demoScreen<Typography>("demo/typography"),
+        demoScreen<TextInputs>("demo/text-inputs"),
+        demoScreen<Buttons>("demo/buttons"),
+        demoScreen<Ranges>("demo/ranges"),
+        demoScreen<Colors>("demo/colors"),
+        builtScene("table/100x10", [](Div *container) { buildTable(container, 100, 10); }),
+        builtScene("table/1000x10", [](Div *container) { buildTable(container, 1000, 10); }),
+        builtScene("nesting/64", [](Div *container) { buildNesting(container, 64); }),
+        builtScene("nesting/256", [](Div *container) { buildNesting(container, 256); }),
+        builtScene("text/100", [](Div *container) { buildLongText(container, 100); }),
+        builtScene("text/1000", [](Div *container) { buildLongText(container, 1000); })
+    };
+
+    std::vector<Result> results{};
+    try {
+        for (const auto &s: scenes) {
+            if (!options.filter.empty() && s.name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            std::cerr << "Running " << s.name << "..." << std::endl;
+            results.push_back(s.run(options));
+        }
+    } catch (const std::runtime_error &e) {
+        std::string error_msg = std::string("Caught a fatal error: ") + std::string(e.what());
+        std::cerr << error_msg << std::endl;
+        return -1;
+    }
+
+    if (options.json == "-") {
+        reportJSON(std::cout, options, results);
+    } else {
+        report(std::cout, results);
+        if (!options.json.empty()) {
+            std::ofstream file(options.json);
+            reportJSON(file, options, results);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <psychic-ui/Div.hpp>
+#include <psychic-ui/components/Label.hpp>
+#include <psychic-ui/components/Text.hpp>
+#include <psychic-ui/components/Scroller.hpp>
+
+namespace psychic_ui {
+    namespace benchmark {
+
+        /**
+         * Scrolling table of labels
+         */
+        inline void buildTable(Div *container, const int rows, const int columns) {
+            auto table = std::make_shared<Div>();
+            table->style()
+                 ->set(flexDirection, "column");
+
+            for (int row = 0; row < rows; ++row) {
+                auto line = table->add<Div>();
+                line->addClassName(row % 2 ? "odd" : "even");
+                line->style()
+                    ->set(flexDirection, "row")
+                    ->set(borderBottom, 1)
+                    ->set(borderColor, 0x20FFFFFF);
+                for (int column = 0; column < columns; ++column) {
+                    line->add<Label>("Cell " + std::to_string(row) + ":" + std::to_string(column))
+                        ->style()
+                        ->set(grow, 1)
+                        ->set(basis, 0)
+                        ->set(padding, 4);
+                }
+            }
+
+            container->add<Scroller>(table)
+                     ->style()
+                     ->set(grow, 1);
+        }
+
+        /**
+         * Chain of nested divs with borders, padding and radiuses
+         */
+        inline void buildNesting(Div *container, const int depth) {
+            Div *parent = container;
+            for (int i = 0; i < depth; ++i) {
+                auto div = parent->add<Div>();
+                div->style()
+                   ->set(grow, 1)
+                   ->set(padding, 1)
+                   ->set(border, 1)
+                   ->set(borderRadius, 2)
+                   ->set(borderColor, i % 2 ? 0x40FFFFFF : 0x40000000)
+                   ->set(backgroundColor, i % 2 ? 0x10FFFFFF : 0x10000000);
+                parent = div.get();
+            }
+        }
+
+        /**
+         * Long multiline text
+         */
+        inline void buildLongText(Div *container, const int paragraphs) {
+            std::string text{};
+            for (int i = 0; i < paragraphs; ++i) {
+                text += "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt "
+                        "ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation "
+                        "ullamco laboris nisi ut aliquip ex ea commodo consequat.\n";
+            }
+
+            auto content = std::make_shared<Div>();
+            auto textBox = content->add<Text>(text);
+            textBox->setMultiline(true);
+
+            container->add<Scroller>(content)
+                     ->style()
+                     ->set(grow, 1);
+        }
+    }
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include "Animator.hpp"
+#include "Div.hpp"
+
+namespace psychic_ui {
+
+    Animator &Animator::getInstance() {
+        // Leaked on purpose, divs can be destroyed during static destruction
+        static auto *instance = new Animator();
+        return *instance;
+    }
+
+    void Animator::animate(Div *div, const ColorProperty property, const Color from, const Color to, const Transition &timing) {
+        Animation animation{};
+        animation.div       = div;
+        animation.color     = true;
+        animation.property  = property;
+        animation.fromColor = from;
+        animation.toColor   = to;
+        animation.timing    = timing;
+        start(animation);
+    }
+
+    void Animator::animate(Div *div, const FloatProperty property, const float from, const float to, const Transition &timing) {
+        Animation animation{};
+        animation.div      = div;
+        animation.property = property;
+        animation.from     = from;
+        animation.to       = to;
+        animation.timing   = timing;
+        start(animation);
+    }
+
+    void Animator::start(Animation animation) {
+        animation.start = Clock::now();
+        std::lock_guard<std::mutex> lock(_mutex);
+        cancel(animation.div, animation.color, animation.property);
+        _animations.push_back(animation);
+    }
+
+    bool Animator::target(const Div *div, const ColorProperty property, Color &to) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const Animation             *animation = find(div, true, property);
+        if (animation) {
+            to = animation->toColor;
+        }
+        return animation != nullptr;
+    }
+
+    bool Animator::target(const Div *div, const FloatProperty property, float &to) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const Animation             *animation = find(div, false, property);
+        if (animation) {
+            to = animation->to;
+        }
+        return animation != nullptr;
+    }
+
+    void Animator::cancel(const Div *div, const ColorProperty property) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        cancel(div, true, property);
+    }
+
+    void Animator::cancel(const Div *div, const FloatProperty property) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        cancel(div, false, property);
+    }
+
+    void Animator::cancel(const Div *div) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _animations.erase(
+            std::remove_if(
+                _animations.begin(), _animations.end(),
+                [div](const Animation &animation) { return animation.div == div; }
+            ),
+            _animations.end()
+        );
+        // The div can go away while the updates of the frame are being applied
+        for (auto &update: _updates) {
+            if (update.div == div) {
+                update.div = nullptr;
+            }
+        }
+    }
+
+    bool Animator::active() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return !_animations.empty();
+    }
+
+    void Animator::tick(const Clock::time_point now) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _updates.clear();
+            for (auto &animation: _animations) {
+                auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - animation.start) - animation.timing.delay;
+                if (elapsed.count() < 0) {
+                    // Delayed, the div still shows the value it started from
+                    continue;
+                }
+                float progress = animation.timing.duration.count() > 0
+                                 ? std::min(1.0f, static_cast<float>(elapsed.count()) / animation.timing.duration.count())
+                                 : 1.0f;
+                float eased    = ease(animation.timing.easing, progress);
+                animation.finished = progress >= 1.0f;
+                _updates.push_back(
+                    {
+                        animation.div,
+                        animation.color,
+                        animation.property,
+                        animation.color ? interpolate(animation.fromColor, animation.toColor, eased) : 0,
+                        animation.color ? 0.0f : interpolate(animation.from, animation.to, eased),
+                        animation.finished
+                    }
+                );
+            }
+            _animations.erase(
+                std::remove_if(
+                    _animations.begin(), _animations.end(),
+                    [](const Animation &animation) { return animation.finished; }
+                ),
+                _animations.end()
+            );
+        }
+
+        // Applied outside of the lock, updating a div can restyle or destroy others
+        for (std::size_t i = 0;; ++i) {
+            Update update{};
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (i >= _updates.size()) {
+                    break;
+                }
+                update = _updates[i];
+                if (update.div && update.finished) {
+                    Div *div = update.div;
+                    div->_animated = std::any_of(
+                        _animations.cbegin(), _animations.cend(),
+                        [div](const Animation &animation) { return animation.div == div; }
+                    );
+                }
+            }
+            if (!update.div) {
+                continue;
+            }
+            if (update.color) {
+                update.div->setAnimatedValue(static_cast<ColorProperty>(update.property), update.colorValue);
+            } else {
+                update.div->setAnimatedValue(static_cast<FloatProperty>(update.property), update.value);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _updates.clear();
+    }
+
+    void Animator::cancel(const Div *div, const bool color, const int property) {
+        _animations.erase(
+            std::remove_if(
+                _animations.begin(), _animations.end(),
+                [div, color, property](const Animation &animation) {
+                    return animation.div == div && animation.color == color && animation.property == property;
+                }
+            ),
+            _animations.end()
+        );
+    }
+
+    const Animator::Animation *Animator::find(const Div *div, const bool color, const int property) const {
+        for (const auto &animation: _animations) {
+            if (animation.div == div && animation.color == color && animation.property == property) {
+                return &animation;
+            }
+        }
+        return nullptr;
+    }
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include "style/Transition.hpp"
+
+namespace psychic_ui {
+
+    class Div;
+
+    /**
+     * @class Animator
+     *
+     * Runs the style animations of every div.
+     *
+     * Animations write their interpolated values straight into the computed style of their
+     * div, so paint-only properties like colors, opacity and transforms animate without restyling or
+     * laying out anything. Layout properties update the yoga node of their div only.
+     * Every animation is advanced once per frame by the main loop, which keeps drawing
+     * frames only while animations are running.
+     *
+     * Animations are started by restyles, when a property with a `transition` changes, or
+     * with `Div::animate`. Restyles can happen on the frame threads, starting, retargeting
+     * and cancelling animations is thread safe.
+     */
+    class Animator {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * Leaked on purpose, divs can be destroyed during static destruction
+         */
+        static Animator &getInstance();
+
+        /**
+         * Animate a property of a div, replacing its running animation
+         */
+        void animate(Div *div, ColorProperty property, Color from, Color to, const Transition &timing);
+        void animate(Div *div, FloatProperty property, float from, float to, const Transition &timing);
+
+        /**
+         * Value a running animation goes to
+         * @return Whether the property of the div is animating
+         */
+        bool target(const Div *div, ColorProperty property, Color &to) const;
+        bool target(const Div *div, FloatProperty property, float &to) const;
+
+        void cancel(const Div *div, ColorProperty property);
+        void cancel(const Div *div, FloatProperty property);
+
+        /**
+         * Cancel all the animations of a div, without changing its style
+         * Linear in the number of running animations, every destroyed div calls it.
+         */
+        void cancel(const Div *div);
+
+        /**
+         * Whether animations are running, the main loop then keeps drawing
+         */
+        bool active() const;
+
+        /**
+         * Advance the animations to the frame time and apply their values
+         * Called once per frame from the main thread, finished animations are applied one last time and removed.
+         */
+        void tick(Clock::time_point now = Clock::now());
+
+    protected:
+        Animator() = default;
+
+        struct Animation {
+            Div                       *div{nullptr};
+            bool                      color{false};
+            int                       property{0};
+            Color                     fromColor{0};
+            Color                     toColor{0};
+            float                     from{0.0f};
+            float                     to{0.0f};
+            Clock::time_point         start{};
+            Transition                timing{};
+            bool                      finished{false};
+        };
+
+        struct Update {
+            Div   *div;
+            bool  color;
+            int   property;
+            Color colorValue;
+            float value;
+            bool  finished;
+        };
+
+        mutable std::mutex     _mutex{};
+        std::vector<Animation> _animations{};
+        std::vector<Update>    _updates{};
+
+        void start(Animation animation);
+        void cancel(const Div *div, bool color, int property);
+        const Animation *find(const Div *div, bool color, int property) const;
+    };
+
+}
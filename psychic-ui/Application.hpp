@@ -1,13 +1,20 @@
 #pragma once
 
-#ifdef USE_GLFW
-#include "applications/GLFWApplication.hpp"
-using Impl = psychic_ui::GLFWApplication;
+#if defined(USE_GLFW) + defined(USE_SDL2) + defined(USE_HEADLESS) > 1
+#error "Only one of USE_GLFW, USE_SDL2 and USE_HEADLESS can be defined"
 #endif
 
-#ifdef USE_SDL2
+#if defined(USE_GLFW)
+#include "applications/GLFWApplication.hpp"
+using Impl = psychic_ui::GLFWApplication;
+#elif defined(USE_SDL2)
 #include "applications/SDL2Application.hpp"
 using Impl = psychic_ui::SDL2Application;
+#elif defined(USE_HEADLESS)
+#include "applications/HeadlessApplication.hpp"
+using Impl = psychic_ui::HeadlessApplication;
+#else
+#error "Define one of USE_GLFW, USE_SDL2 or USE_HEADLESS to pick the application backend"
 #endif
 
 namespace psychic_ui {
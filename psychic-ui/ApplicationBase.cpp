@@ -1,9 +1,272 @@
+#include <algorithm>
 #include <memory>
 #include "ApplicationBase.hpp"
+#include "Animator.hpp"
 #include "Window.hpp"
+#include "gl/GrGLInterface.h"
+#include "signals/CoalescingSignal.hpp"
+#include "utils/Profiler.hpp"
 
 namespace psychic_ui {
 
+    // region Application Tasks
+
+    void ApplicationBase::post(std::function<void()> task) {
+        _tasks.post(std::move(task));
+        wakeUp();
+    }
+
+    std::chrono::microseconds ApplicationBase::taskBudget() const {
+        return _taskBudget;
+    }
+
+    void ApplicationBase::setTaskBudget(const std::chrono::microseconds budget) {
+        _taskBudget = budget;
+    }
+
+    bool ApplicationBase::runTasks() {
+        _tasks.drain(_taskBudget);
+        return !_tasks.empty();
+    }
+
+    // endregion
+
+    // region Graphics
+
+    bool ApplicationBase::sharedContext() const {
+        return _sharedContext;
+    }
+
+    void ApplicationBase::setSharedContext(const bool sharedContext) {
+        _sharedContext = sharedContext;
+    }
+
+    std::size_t ApplicationBase::resourceCacheLimit() const {
+        return _resourceCacheLimit;
+    }
+
+    void ApplicationBase::setResourceCacheLimit(const std::size_t bytes) {
+        _resourceCacheLimit = bytes;
+        if (_sharedGrContext) {
+            applyResourceCacheLimit(_sharedGrContext.get());
+        }
+    }
+
+    sk_sp<GrContext> ApplicationBase::grContext() {
+        if (!_sharedContext) {
+            sk_sp<GrContext> context = GrContext::MakeGL(GrGLMakeNativeInterface());
+            applyResourceCacheLimit(context.get());
+            return context;
+        }
+
+        if (!_sharedGrContext) {
+            _sharedGrContext = GrContext::MakeGL(GrGLMakeNativeInterface());
+            applyResourceCacheLimit(_sharedGrContext.get());
+        }
+        return _sharedGrContext;
+    }
+
+    void ApplicationBase::applyResourceCacheLimit(GrContext *context) const {
+        if (context && _resourceCacheLimit > 0) {
+            int maxResources = 0;
+            context->getResourceCacheLimits(&maxResources, nullptr);
+            context->setResourceCacheLimits(maxResources, _resourceCacheLimit);
+        }
+    }
+
+    void ApplicationBase::releaseSharedContext() {
+        if (_sharedGrContext) {
+            _sharedGrContext->abandonContext();
+            _sharedGrContext.reset();
+        }
+        _currentContextWindow = nullptr;
+    }
+
+    // endregion
+
+    // region Frames
+
+    unsigned int ApplicationBase::frameThreads() const {
+        return _frameThreads;
+    }
+
+    void ApplicationBase::setFrameThreads(const unsigned int threads) {
+        _frameThreads = threads > 0 ? threads : 1;
+        _framePool.reset();
+    }
+
+    int ApplicationBase::renderWindows(const std::vector<SystemWindow *> &windows) {
+        if (_frameThreads < 2 || windows.size() < 2) {
+            int rendered = 0;
+            for (auto systemWindow: windows) {
+                if (systemWindow->render()) {
+                    ++rendered;
+                }
+            }
+            return rendered;
+        }
+
+        std::vector<SystemWindow *> ready{};
+        for (auto systemWindow: windows) {
+            if (systemWindow->ready()) {
+                ready.push_back(systemWindow);
+            }
+        }
+        if (ready.empty()) {
+            return 0;
+        }
+
+        PSYCHIC_PROFILE_FRAME();
+
+        // Event handlers and signal slots can touch anything, they run on the main thread first
+        {
+            PSYCHIC_PROFILE_SCOPE("input");
+            for (auto systemWindow: ready) {
+                systemWindow->dispatchInput();
+            }
+        }
+        {
+            PSYCHIC_PROFILE_SCOPE("signals");
+            CoalescingSignalBase::flushAll();
+        }
+
+        std::vector<StyleManager *> styleManagers{};
+        for (auto systemWindow: ready) {
+            StyleManager *styleManager = systemWindow->window()->styleManager();
+            if (std::find(styleManagers.cbegin(), styleManagers.cend(), styleManager) == styleManagers.cend()) {
+                styleManagers.push_back(styleManager);
+                styleManager->beginFrame();
+            }
+        }
+
+        // The calling thread takes part in the work
+        if (!_framePool) {
+            _framePool = std::make_unique<ThreadPool>(_frameThreads - 1);
+        }
+        std::vector<sk_sp<SkPicture>> pictures(ready.size());
+        try {
+            _framePool->parallelFor(
+                ready.size(), [&ready, &pictures](std::size_t i) {
+                    pictures[i] = ready[i]->window()->recordFrame();
+                }
+            );
+        } catch (...) {
+            for (auto styleManager: styleManagers) {
+                styleManager->endFrame();
+            }
+            throw;
+        }
+        for (auto styleManager: styleManagers) {
+            styleManager->endFrame();
+        }
+
+        // GL contexts can only be current on one thread at a time, present one window after the other
+        for (std::size_t i = 0; i < ready.size(); ++i) {
+            ready[i]->presentRecordedFrame(std::move(pictures[i]));
+        }
+
+        return static_cast<int>(ready.size());
+    }
+
+    FrameScheduler &ApplicationBase::frameScheduler() {
+        return _frameScheduler;
+    }
+
+    void ApplicationBase::runScheduled(const FrameScheduler::Clock::time_point now) {
+        {
+            PSYCHIC_PROFILE_SCOPE("timers");
+            _frameScheduler.runTimers(now);
+        }
+        {
+            PSYCHIC_PROFILE_SCOPE("tasks");
+            runTasks();
+        }
+        {
+            PSYCHIC_PROFILE_SCOPE("animations");
+            _frameScheduler.runFrameCallbacks(now);
+            Animator::getInstance().tick(now);
+        }
+        // Flushed before deciding what to draw since the slots can change any window
+        {
+            PSYCHIC_PROFILE_SCOPE("signals");
+            CoalescingSignalBase::flushAll();
+        }
+    }
+
+    int ApplicationBase::frame(const std::vector<SystemWindow *> &windows) {
+        auto now = FrameScheduler::Clock::now();
+        _frameScheduler.frameStarted(now);
+        _swapWaited = false;
+        runScheduled(now);
+
+        // Watched stylesheets are checked here so that asking the windows if they changed has no side effects,
+        // managers shared by several windows only read their files once, the checks are throttled
+        for (auto systemWindow: windows) {
+            systemWindow->window()->styleManager()->reloadStyleSheets();
+        }
+
+        int                         shown = 0;
+        std::vector<SystemWindow *> changed{};
+        for (auto systemWindow: windows) {
+            if (!systemWindow->ready()) {
+                continue;
+            }
+            ++shown;
+            if (!_frameScheduler.skipIdleFrames() || systemWindow->needsFrame()) {
+                changed.push_back(systemWindow);
+            } else {
+                systemWindow->frameSkipped();
+            }
+        }
+
+        if (!changed.empty()) {
+            renderWindows(changed);
+        }
+
+        // Cleanup dirty managers
+        for (auto systemWindow: windows) {
+            systemWindow->window()->styleManager()->setValid();
+        }
+
+        if (!changed.empty()) {
+            _frameScheduler.pace();
+        }
+
+        return shown;
+    }
+
+    std::chrono::microseconds ApplicationBase::idleTimeout(const std::vector<SystemWindow *> &windows) {
+        const auto immediately = std::chrono::microseconds{0};
+        if (!_frameScheduler.skipIdleFrames()
+            || !_tasks.empty()
+            || _frameScheduler.hasFrameCallbacks()
+            || Animator::getInstance().active()
+            || CoalescingSignalBase::hasPending()) {
+            return immediately;
+        }
+
+        auto timeout = _frameScheduler.timeUntilNextTimer();
+        bool shown   = false;
+        for (auto systemWindow: windows) {
+            if (!systemWindow->ready()) {
+                continue;
+            }
+            shown = true;
+            if (systemWindow->needsFrame()) {
+                return immediately;
+            }
+            if (systemWindow->window()->styleManager()->watchingStyleSheets()) {
+                // Wake up to check the files for changes
+                timeout = std::min<std::chrono::microseconds>(timeout, std::chrono::milliseconds(250));
+            }
+        }
+
+        // Nothing shown, the next frame ends the main loop
+        return shown ? timeout : immediately;
+    }
+
+    // endregion
+
     SystemWindow::SystemWindow(ApplicationBase *application, std::shared_ptr<Window> window) :
         _application(application),
         _window(window) {
@@ -12,10 +275,73 @@ namespace psychic_ui {
         _height = window->windowHeight();
     }
 
+    SystemWindow::~SystemWindow() {
+        if (_application && _application->_currentContextWindow == this) {
+            _application->_currentContextWindow = nullptr;
+        }
+    }
+
+    ApplicationBase *SystemWindow::application() const {
+        return _application;
+    }
+
     std::shared_ptr<Window> SystemWindow::window() const {
         return _window;
     }
 
+    void SystemWindow::activateContext() {
+        if (_application->_currentContextWindow == this || _window->renderThreadActive()) {
+            return;
+        }
+        _application->_currentContextWindow = this;
+        makeContextCurrent();
+        if (_application->_sharedGrContext) {
+            _application->_sharedGrContext->resetContext();
+        }
+    }
+
+    void SystemWindow::detachContext() {
+        releaseContext();
+        if (_application->_currentContextWindow == this) {
+            _application->_currentContextWindow = nullptr;
+        }
+    }
+
+    bool SystemWindow::ready() {
+        return _window->getVisible();
+    }
+
+    bool SystemWindow::needsFrame() {
+        return !_inputQueue.empty() || _window->needsFrame();
+    }
+
+    void SystemWindow::presentRecordedFrame(sk_sp<SkPicture> picture) {
+        activateContext();
+        _window->drawRecordedFrame(std::move(picture));
+        if (!_window->renderThreadActive()) {
+            PSYCHIC_PROFILE_SCOPE("swap");
+            swapFrame();
+        }
+        framePresented();
+    }
+
+    void SystemWindow::swapFrame() {
+        int interval = 0;
+        if (_application->_frameScheduler.pacing() == FrameScheduler::Pacing::VSync && !_application->_swapWaited) {
+            interval = 1;
+            _application->_swapWaited = true;
+        }
+        if (interval != _swapInterval) {
+            setSwapInterval(interval);
+            _swapInterval = interval;
+        }
+        swapBuffers();
+    }
+
+    bool SystemWindow::hardwareAccelerated() const {
+        return true;
+    }
+
     int SystemWindow::getX() const {
         return _x;
     }
@@ -43,4 +369,133 @@ namespace psychic_ui {
     void SystemWindow::startTextInput() {}
 
     void SystemWindow::stopTextInput() {}
+
+    // region Input
+
+    void SystemWindow::queueInput(InputEvent event) {
+        if (event.received == std::chrono::steady_clock::time_point{}) {
+            event.received = std::chrono::steady_clock::now();
+        }
+        if (_inputRecording) {
+            _inputRecording->add(event);
+        }
+        if (_window->rawInput()) {
+            dispatchInputEvent(event);
+        } else {
+            _inputQueue.push(std::move(event));
+        }
+    }
+
+    void SystemWindow::dispatchInput() {
+        _inputQueue.drain(
+            [this](const InputEvent &event) {
+                dispatchInputEvent(event);
+            }
+        );
+    }
+
+    void SystemWindow::dispatchInput(const std::function<void(const InputEvent &event, std::chrono::nanoseconds duration)> &dispatched) {
+        _inputQueue.drain(
+            [this, &dispatched](const InputEvent &event) {
+                auto start = std::chrono::steady_clock::now();
+                dispatchInputEvent(event);
+                dispatched(event, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+            }
+        );
+    }
+
+    bool SystemWindow::replayInput(const InputEvent &event) {
+        InputEvent replayed = event;
+        replayed.received = std::chrono::steady_clock::now();
+        if (_window->rawInput()) {
+            dispatchInputEvent(replayed);
+            return true;
+        }
+        _inputQueue.push(std::move(replayed));
+        return false;
+    }
+
+    std::shared_ptr<InputRecording> SystemWindow::inputRecording() const {
+        return _inputRecording;
+    }
+
+    void SystemWindow::setInputRecording(std::shared_ptr<InputRecording> recording) {
+        _inputRecording = std::move(recording);
+    }
+
+    void SystemWindow::resized() {
+        if (_inputRecording) {
+            _inputRecording->add(InputEvent::resize(_width, _height));
+        }
+        _window->windowResized(_width, _height);
+    }
+
+    const LatencyHistogram &SystemWindow::inputLatency() const {
+        return _inputLatency;
+    }
+
+    const LatencyHistogram &SystemWindow::dispatchLatency() const {
+        return _dispatchLatency;
+    }
+
+    void SystemWindow::resetLatency() {
+        _inputLatency.clear();
+        _dispatchLatency.clear();
+        _unpresentedInput.clear();
+    }
+
+    void SystemWindow::framePresented() {
+        if (_unpresentedInput.empty()) {
+            return;
+        }
+        auto now = std::chrono::steady_clock::now();
+        for (const auto &received: _unpresentedInput) {
+            _inputLatency.add(std::chrono::duration_cast<std::chrono::microseconds>(now - received));
+        }
+        _unpresentedInput.clear();
+    }
+
+    void SystemWindow::frameSkipped() {
+        _unpresentedInput.clear();
+    }
+
+    void SystemWindow::dispatchInputEvent(const InputEvent &event) {
+        if (event.received != std::chrono::steady_clock::time_point{}) {
+            _dispatchLatency.add(
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - event.received)
+            );
+            _unpresentedInput.push_back(event.received);
+        }
+
+        switch (event.type) {
+            case InputEventType::MouseMove:
+                _window->mouseMoved(event.mouseX, event.mouseY, event.buttons, event.modifiers, false);
+                break;
+            case InputEventType::MouseButton:
+                _window->mouseButton(event.mouseX, event.mouseY, event.button, event.down, event.modifiers);
+                break;
+            case InputEventType::MouseScroll:
+                _window->mouseScrolled(event.mouseX, event.mouseY, event.scrollX, event.scrollY);
+                break;
+            case InputEventType::KeyDown:
+                _window->keyDown(event.key, event.modifiers);
+                break;
+            case InputEventType::KeyRepeat:
+                _window->keyRepeat(event.key, event.modifiers);
+                break;
+            case InputEventType::KeyUp:
+                _window->keyUp(event.key, event.modifiers);
+                break;
+            case InputEventType::Character:
+                _window->keyboardCharacterEvent(event.character);
+                break;
+            case InputEventType::Resize:
+                _width  = event.width;
+                _height = event.height;
+                _window->windowResized(_width, _height);
+                break;
+        }
+    }
+
+    // endregion
 }
@@ -1,18 +1,162 @@
 #pragma once
 
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <vector>
+#include "GrContext.h"
+#include "SkPicture.h"
 #include "psychic-ui.hpp"
+#include "InputQueue.hpp"
+#include "InputRecording.hpp"
+#include "FrameScheduler.hpp"
+#include "TaskQueue.hpp"
+#include "ThreadPool.hpp"
+#include "utils/LatencyHistogram.hpp"
 
 namespace psychic_ui {
     class Window;
+    class SystemWindow;
 
     class ApplicationBase {
+        friend class SystemWindow;
+
     public:
         virtual void init() = 0;
         virtual void mainloop() = 0;
         virtual void open(std::shared_ptr<Window> window) = 0;
         virtual void close(std::shared_ptr<Window> window) = 0;
         virtual void shutdown() = 0;
+
+        // region Tasks
+
+        /**
+         * Run a task on the main loop thread
+         * This is the only way for other threads to touch the UI, it is safe
+         * to call from any thread and wakes the main loop if it is waiting for events.
+         * @param task Task to run
+         */
+        void post(std::function<void()> task);
+
+        /**
+         * Time allowed every frame for running posted tasks
+         * Tasks left over are run on the next frames so that input handling is never starved.
+         */
+        std::chrono::microseconds taskBudget() const;
+        void setTaskBudget(std::chrono::microseconds budget);
+
+        // endregion
+
+        // region Graphics
+
+        /**
+         * Share a single GL share group and Skia context between all the windows
+         * Glyph atlases, path caches and textures are then created once for the whole
+         * application instead of once per window. Has to be set before opening windows.
+         */
+        bool sharedContext() const;
+        void setSharedContext(bool sharedContext);
+
+        /**
+         * Skia GPU resource cache budget in bytes, 0 keeps Skia's default
+         * Applies to the shared context, or to each window's own context.
+         */
+        std::size_t resourceCacheLimit() const;
+        void setResourceCacheLimit(std::size_t bytes);
+
+        /**
+         * Skia context for a window, the shared one in shared context mode
+         * The window's GL context has to be current.
+         */
+        sk_sp<GrContext> grContext();
+
+        // endregion
+
+        // region Frames
+
+        /**
+         * Number of threads producing the windows' frames, 1 to produce them one after the other
+         * With several windows open, their restyle, layout and recording run in parallel while
+         * input, coalesced signals and presenting stay on the main thread. Slots connected to
+         * style and layout signals are then called from the frame threads.
+         */
+        unsigned int frameThreads() const;
+        void setFrameThreads(unsigned int threads);
+
+        /**
+         * Pacing, timers and frame callbacks of the main loop
+         */
+        FrameScheduler &frameScheduler();
+
+        // endregion
+
+    protected:
+        TaskQueue                 _tasks{};
+        std::chrono::microseconds _taskBudget{4000};
+
+        bool             _sharedContext{false};
+        std::size_t      _resourceCacheLimit{0};
+        sk_sp<GrContext> _sharedGrContext{nullptr};
+        /**
+         * System window whose GL context is current
+         */
+        SystemWindow     *_currentContextWindow{nullptr};
+        /**
+         * Whether a window already waited for the display refresh when swapping this frame
+         */
+        bool             _swapWaited{false};
+
+        unsigned int                _frameThreads{1};
+        std::unique_ptr<ThreadPool> _framePool{nullptr};
+        FrameScheduler              _frameScheduler{};
+
+        void applyResourceCacheLimit(GrContext *context) const;
+
+        /**
+         * Release the shared Skia context once nothing can draw anymore
+         * The context is abandoned since the GL contexts it was using may already be gone.
+         */
+        void releaseSharedContext();
+
+        /**
+         * Wake the main loop if it is blocked waiting for events
+         * Called from the posting thread.
+         */
+        virtual void wakeUp() {}
+
+        /**
+         * Run the posted tasks within the frame budget
+         * @return Whether tasks are left for the next frame
+         */
+        bool runTasks();
+
+        /**
+         * Produce and present a frame for each window, in parallel when enabled
+         * @param windows Windows to draw
+         * @return Number of windows drawn
+         */
+        int renderWindows(const std::vector<SystemWindow *> &windows);
+
+        /**
+         * Run what is scheduled before drawing: due timers, posted tasks, frame callbacks,
+         * style animations and coalesced signals, in that order
+         */
+        void runScheduled(FrameScheduler::Clock::time_point now);
+
+        /**
+         * One iteration of the main loop, once the events were polled
+         * Runs the scheduled work, draws the windows that need it and waits for the next frame
+         * when pacing at a fixed rate.
+         * @param windows Windows of the application
+         * @return Number of windows still shown, 0 ends the main loop
+         */
+        int frame(const std::vector<SystemWindow *> &windows);
+
+        /**
+         * How long the main loop can wait for events before the next frame
+         * 0 when there is something to draw, `std::chrono::microseconds::max()` to wait until an event comes.
+         */
+        std::chrono::microseconds idleTimeout(const std::vector<SystemWindow *> &windows);
     };
 
     class SystemWindow {
@@ -20,11 +164,34 @@ namespace psychic_ui {
 
     public:
         SystemWindow(ApplicationBase *application, std::shared_ptr<Window> window);
+        virtual ~SystemWindow();
 
+        ApplicationBase *application() const;
         std::shared_ptr<Window> window() const;
 
         virtual bool render() = 0;
 
+        /**
+         * Whether the window is shown and has to be drawn this frame
+         */
+        virtual bool ready();
+
+        /**
+         * Whether the window received input or changed since its last frame
+         */
+        bool needsFrame();
+
+        /**
+         * Draw a frame recorded by `Window::recordFrame()` and present it
+         */
+        void presentRecordedFrame(sk_sp<SkPicture> picture);
+
+        /**
+         * Whether the window is backed by an OpenGL context
+         * Windows that aren't are rendered in a CPU raster surface.
+         */
+        virtual bool hardwareAccelerated() const;
+
         int getX() const;
         int getY() const;
         int getWidth() const;
@@ -48,10 +215,145 @@ namespace psychic_ui {
         virtual void startTextInput();
         virtual void stopTextInput();
 
+        /**
+         * Queue an input event for the next frame
+         * If the window asked for raw input, the event is dispatched right away instead.
+         * @param event Event to queue
+         */
+        void queueInput(InputEvent event);
+
+        /**
+         * Dispatch the input events queued since the last frame
+         * Called by the backends right before drawing the window.
+         */
+        void dispatchInput();
+
+        /**
+         * Dispatch the queued input events, reporting the time spent on each one
+         * @param dispatched Callback receiving each event after it was dispatched
+         */
+        void dispatchInput(const std::function<void(const InputEvent &event, std::chrono::nanoseconds duration)> &dispatched);
+
+        /**
+         * Queue an event as if the backend just received it, without recording it
+         * Replayed events are merged and dispatched like live input, so a replay
+         * reproduces what the window handled during the original session.
+         * @return Whether the event was dispatched right away because the window asked for raw input
+         */
+        bool replayInput(const InputEvent &event);
+
+        /**
+         * Record the input received by this window, nullptr to stop recording
+         */
+        std::shared_ptr<InputRecording> inputRecording() const;
+        void setInputRecording(std::shared_ptr<InputRecording> recording);
+
+        // region Latency
+
+        /**
+         * Time from the backend receiving each input event to the first frame presented after it was dispatched
+         * With a render thread, frames count as presented when they are handed to it. When idle frames are
+         * skipped, input that doesn't lead to a frame is only counted in the dispatch latency.
+         */
+        const LatencyHistogram &inputLatency() const;
+
+        /**
+         * Time from the backend receiving each input event to dispatching it to the window
+         */
+        const LatencyHistogram &dispatchLatency() const;
+
+        void resetLatency();
+
+        // endregion
+
+        // region Context
+
+        /**
+         * Make the GL context current on the calling thread
+         */
+        virtual void makeContextCurrent() {}
+
+        /**
+         * Release the GL context from the calling thread
+         * So that a render thread can make it current.
+         */
+        virtual void releaseContext() {}
+
+        /**
+         * Present the frame drawn into the GL context, from the thread it is current on
+         */
+        virtual void swapBuffers() {}
+
+        /**
+         * Set the number of display refreshes a swap waits for, on the current context
+         */
+        virtual void setSwapInterval(int /*interval*/) {}
+
+        /**
+         * Release the context from the main thread and forget it was current there
+         * Called when handing the context over to a render thread.
+         */
+        void detachContext();
+
+        // endregion
+
     protected:
         ApplicationBase             *_application;
         std::shared_ptr<Window> _window;
 
+        /**
+         * Input events received since the last frame
+         */
+        InputQueue _inputQueue{};
+
+        std::shared_ptr<InputRecording> _inputRecording{nullptr};
+
+        LatencyHistogram                                   _inputLatency{};
+        LatencyHistogram                                   _dispatchLatency{};
+        /**
+         * Reception time of the events dispatched since the last presented frame
+         */
+        std::vector<std::chrono::steady_clock::time_point> _unpresentedInput{};
+
+        /**
+         * Record the latency of the input dispatched since the last frame, called once the frame is presented
+         */
+        void framePresented();
+
+        /**
+         * Forget the input dispatched since the last frame, called when the window was left idle
+         * It changed nothing to draw, so it only counts in the dispatch latency.
+         */
+        void frameSkipped();
+
+        void dispatchInputEvent(const InputEvent &event);
+
+        /**
+         * Tell the window about its new size, called by the backends when it changes
+         */
+        void resized();
+
+        /**
+         * Make this window's GL context current before drawing into it
+         * Does nothing if it already is, or if the window renders on its own thread,
+         * otherwise resets the shared Skia context since the GL state it tracks
+         * belongs to the previous context.
+         */
+        void activateContext();
+
+        /**
+         * Present the frame from the main thread
+         * With vsync pacing only the first window swapping in a frame waits for the display
+         * refresh, otherwise every window would wait its turn and N windows would run at
+         * refresh / N.
+         */
+        void swapFrame();
+
+        /**
+         * Swap interval set on our context, -1 until the first swap
+         */
+        int _swapInterval{-1};
+
         bool _dragging{false};
         int  _windowDragMouseX{0};
         int  _windowDragMouseY{0};
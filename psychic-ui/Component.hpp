@@ -3,6 +3,7 @@
 #include <memory>
 #include "Skin.hpp"
 #include "Div.hpp"
+#include "utils/Log.hpp"
 
 namespace psychic_ui {
 
@@ -12,19 +13,28 @@ namespace psychic_ui {
         Component();
 
     public:
+        ~Component();
 
         const std::shared_ptr<T> skin() const { return _skin; };
         Component<T> *setSkin(std::shared_ptr<T> skin);
 
     protected:
-        void draw(SkCanvas */*canvas*/) override {/*Skin Manages drawing*/}
+        void draw(SkCanvas *canvas) override;
 
         virtual void skinChanged() {}
 
         void styleUpdated() override;
 
-        std::string        _skinName{};
-        std::shared_ptr<T> _skin{nullptr};
+        std::string                                 _skinName{};
+        std::shared_ptr<T>                          _skin{nullptr};
+        /**
+         * Pool the current skin goes back to when it is replaced or when we are destroyed
+         */
+        std::weak_ptr<SkinPool>                     _skinPool{};
+        /**
+         * Flyweight skin drawing for us when the skin name maps to a renderer
+         */
+        std::shared_ptr<internal::SkinRendererBase> _skinRenderer{nullptr};
 
         // Make some of div's stuff protected since we manage our content
         using Div::add;
@@ -41,13 +51,30 @@ namespace psychic_ui {
         _ignoreInternalLayoutContraints = true;
     }
 
+    template<class T>
+    Component<T>::~Component() {
+        // Only recycle when detached, otherwise the whole tree is going away
+        // and the skin can't be safely removed from us
+        if (_skin && !_parent) {
+            if (auto pool = _skinPool.lock()) {
+                _skin->removedFromComponent();
+                this->remove(_skin);
+                pool->release(std::move(_skin));
+            }
+        }
+    }
+
     template<class T>
     Component<T> *Component<T>::setSkin(std::shared_ptr<T> skin) {
         if (skin != _skin) {
             if (_skin) {
                 _skin->removedFromComponent();
                 this->remove(_skin);
+                if (auto pool = _skinPool.lock()) {
+                    pool->release(std::move(_skin));
+                }
             }
+            _skinPool.reset();
             _skin = skin;
             if (_skin) {
                 // Skin is always in the back so the component can add more
@@ -66,7 +93,27 @@ namespace psychic_ui {
         std::string skinName = _computedStyle->get(StringProperty::skin);
         if (skinName != _skinName) {
             _skinName = skinName;
-            setSkin(std::dynamic_pointer_cast<T>(styleManager()->skin(_skinName)));
+            StyleManager *manager = styleManager();
+            _skinRenderer = manager->skinRenderer(_skinName);
+            if (_skinRenderer && !_skinRenderer->accepts(this)) {
+                PSYCHIC_LOG_WARNING("Skin renderer \"" << _skinName << "\" can't draw a " << tags().back());
+                _skinRenderer = nullptr;
+            }
+            if (_skinRenderer) {
+                setSkin(nullptr);
+            } else {
+                auto pool = manager->skinPool(_skinName);
+                setSkin(std::dynamic_pointer_cast<T>(manager->skin(_skinName)));
+                _skinPool = pool;
+            }
+        }
+    }
+
+    template<class T>
+    void Component<T>::draw(SkCanvas *canvas) {
+        // Skin manages drawing, either as our child or as a shared renderer
+        if (_skinRenderer) {
+            _skinRenderer->draw(this, canvas);
         }
     }
 }
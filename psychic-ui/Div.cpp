@@ -1,9 +1,21 @@
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <GrContext.h>
 #include <SkPaint.h>
 #include <SkDashPathEffect.h>
+#include <SkPictureRecorder.h>
+#include <SkBBHFactory.h>
+#include <SkSurface.h>
 #include "utils/YogaUtils.hpp"
+#include "utils/Profiler.hpp"
+#include "utils/Log.hpp"
+#include "utils/YogaNodePool.hpp"
 #include "yoga/Yoga.h"
+#include "style/StyleParser.hpp"
+#include "Animator.hpp"
 #include "Div.hpp"
 #include "Window.hpp"
 
@@ -22,7 +34,7 @@ namespace psychic_ui {
     bool Div::debugLayout{false};
     #endif
 
-    int Div::idCounter = 0;
+    std::atomic<int> Div::idCounter{0};
 
     Div::Div() :
         Observer(),
@@ -30,7 +42,11 @@ namespace psychic_ui {
         _defaultStyle(std::make_unique<Style>([this]() { invalidateStyle(); })),
         _inlineStyle(std::make_unique<Style>([this]() { invalidateStyle(); })),
         _computedStyle(std::make_unique<Style>()),
+        #ifdef PSYCHIC_UI_POOL_ALLOCATION
+        _yogaNode(YogaNodePool::getInstance().acquire()) {
+        #else
         _yogaNode(YGNodeNew()) {
+        #endif
         setTag("div");
 
         YGNodeSetContext(_yogaNode, this);
@@ -56,7 +72,18 @@ namespace psychic_ui {
     }
 
     Div::~Div() {
+        // Even when not animated anymore, the Animator can still have updates for us in the frame it is applying.
+        // That's a lock and a scan of the running animations for every destroyed div, cheap as long as
+        // only a few transitions run at once, tearing down a tree while hundreds animate pays for each of them.
+        Animator::getInstance().cancel(this);
+
+        #ifdef PSYCHIC_UI_POOL_ALLOCATION
+        // Our children's nodes are still attached, in that case the node is freed, which detaches
+        // them so that they can be recycled when their own divs go away right after us.
+        YogaNodePool::getInstance().release(_yogaNode);
+        #else
         YGNodeFree(_yogaNode);
+        #endif
     }
 
     std::string Div::toString() const {
@@ -171,6 +198,7 @@ namespace psychic_ui {
         // Insert in "reverse" so that we can iterate front-to-back without using a reverse_iterator
         _children.insert(_children.cend() - index, child);
         YGNodeInsertChild(_yogaNode, child->_yogaNode, index);
+        invalidateRenderCache();
         return child;
     }
 
@@ -184,6 +212,7 @@ namespace psychic_ui {
         _children.erase(std::remove(_children.begin(), _children.end(), child), _children.end());
         YGNodeRemoveChild(_yogaNode, child->_yogaNode);
         child->setParent(nullptr);
+        invalidateRenderCache();
     }
 
     void Div::remove(unsigned int index) {
@@ -192,6 +221,7 @@ namespace psychic_ui {
         _children.erase(_children.cend() - index);
         YGNodeRemoveChild(_yogaNode, child->_yogaNode);
         child->setParent(nullptr);
+        invalidateRenderCache();
     }
 
     void Div::removeAll() {
@@ -309,36 +339,50 @@ namespace psychic_ui {
 
     // region Position
 
-    void Div::localToGlobal(int &gx, int &gy, const int x, const int y) const {
-        int lgx = _x + x;
-        int lgy = _y + y;
+    SkMatrix Div::localToGlobalMatrix() const {
+        SkMatrix matrix = SkMatrix::MakeTrans(_x + _scrollX, _y + _scrollY);
+        if (_transformed) {
+            matrix.postConcat(_transform);
+        }
         if (_parent) {
-            _parent->localToGlobal(lgx, lgy, lgx, lgy);
+            matrix.postConcat(_parent->localToGlobalMatrix());
         }
-        gx = lgx + _scrollX;
-        gy = lgy + _scrollY;
+        return matrix;
+    }
+
+    void Div::localToGlobal(int &gx, int &gy, const int x, const int y) const {
+        SkPoint point;
+        localToGlobalMatrix().mapXY(x, y, &point);
+        gx = (int) std::lround(point.x());
+        gy = (int) std::lround(point.y());
     }
 
     void Div::globalToLocal(int &lx, int &ly, const int x, const int y) const {
-        int gx = 0;
-        int gy = 0;
-        localToGlobal(gx, gy);
-        lx = x - gx;
-        ly = y - gy;
+        SkMatrix inverse;
+        if (!localToGlobalMatrix().invert(&inverse)) {
+            // Flattened by a transform, nothing maps back into it
+            lx = std::numeric_limits<int>::min() / 2;
+            ly = std::numeric_limits<int>::min() / 2;
+            return;
+        }
+        SkPoint point;
+        inverse.mapXY(x, y, &point);
+        lx = (int) std::lround(point.x());
+        ly = (int) std::lround(point.y());
     }
 
     void Div::setPosition(int x, int y) {
         _x = x;
         _y = y;
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeLeft, _x);
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeTop, _y);
+        syncPosition(YGEdgeLeft, x);
+        syncPosition(YGEdgeTop, y);
     }
 
     void Div::setPosition(int left, int top, int right, int bottom) {
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeLeft, left);
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeTop, top);
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeRight, right);
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeBottom, bottom);
+        syncPosition(YGEdgeLeft, left);
+        syncPosition(YGEdgeTop, top);
+        syncPosition(YGEdgeRight, right);
+        syncPosition(YGEdgeBottom, bottom);
     }
 
     int Div::x() const {
@@ -347,7 +391,7 @@ namespace psychic_ui {
 
     void Div::setX(int x) {
         _x = x;
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeLeft, _x >= 0 ? _x : YGUndefined);
+        syncPosition(YGEdgeLeft, x >= 0 ? x : YGUndefined);
     }
 
     int Div::y() const {
@@ -356,7 +400,7 @@ namespace psychic_ui {
 
     void Div::setY(int y) {
         _y = y;
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeTop, _y >= 0 ? _y : YGUndefined);
+        syncPosition(YGEdgeTop, y >= 0 ? y : YGUndefined);
     }
 
     int Div::getLeft() const {
@@ -364,7 +408,7 @@ namespace psychic_ui {
     }
 
     void Div::setLeft(int left) {
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeLeft, left);
+        syncPosition(YGEdgeLeft, left);
     }
 
     float Div::getLeftPercent() const {
@@ -373,7 +417,7 @@ namespace psychic_ui {
     }
 
     void Div::setLeftPercent(float leftPercent) {
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeLeft, YogaPercent(leftPercent));
+        syncPosition(YGEdgeLeft, YogaPercent(leftPercent));
     }
 
     int Div::getRight() const {
@@ -381,7 +425,7 @@ namespace psychic_ui {
     }
 
     void Div::setRight(int right) {
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeRight, right);
+        syncPosition(YGEdgeRight, right);
     }
 
     float Div::getRightPercent() const {
@@ -390,7 +434,7 @@ namespace psychic_ui {
     }
 
     void Div::setRightPercent(float rightPercent) {
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeRight, YogaPercent(rightPercent));
+        syncPosition(YGEdgeRight, YogaPercent(rightPercent));
     }
 
     int Div::getTop() const {
@@ -398,7 +442,7 @@ namespace psychic_ui {
     }
 
     void Div::setTop(int top) {
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeTop, top);
+        syncPosition(YGEdgeTop, top);
     }
 
     float Div::getTopPercent() const {
@@ -407,7 +451,7 @@ namespace psychic_ui {
     }
 
     void Div::setTopPercent(float topPercent) {
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeTop, YogaPercent(topPercent));
+        syncPosition(YGEdgeTop, YogaPercent(topPercent));
     }
 
     int Div::getBottom() const {
@@ -415,7 +459,7 @@ namespace psychic_ui {
     }
 
     void Div::setBottom(int bottom) {
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeBottom, bottom);
+        syncPosition(YGEdgeBottom, bottom);
     }
 
     float Div::getBottomPercent() const {
@@ -424,7 +468,7 @@ namespace psychic_ui {
     }
 
     void Div::setBottomPercent(float bottomPercent) {
-        YGNodeStyleSetPosition(_yogaNode, YGEdgeBottom, YogaPercent(bottomPercent));
+        syncPosition(YGEdgeBottom, YogaPercent(bottomPercent));
     }
 
     // endregion
@@ -434,8 +478,8 @@ namespace psychic_ui {
     void Div::setSize(int width, int height) {
         _width  = width;
         _height = height;
-        YGNodeStyleSetWidth(_yogaNode, _width);
-        YGNodeStyleSetHeight(_yogaNode, _height);
+        syncWidth(width);
+        syncHeight(height);
     }
 
     int Div::getWidth() const {
@@ -444,7 +488,7 @@ namespace psychic_ui {
 
     void Div::setWidth(int width) {
         _width = width;
-        YGNodeStyleSetWidth(_yogaNode, _width);
+        syncWidth(width);
     }
 
     int Div::getHeight() const {
@@ -453,7 +497,7 @@ namespace psychic_ui {
 
     void Div::setHeight(int height) {
         _height = height;
-        YGNodeStyleSetHeight(_yogaNode, _height);
+        syncHeight(height);
     }
 
     float Div::getWidthPercent() const {
@@ -462,7 +506,7 @@ namespace psychic_ui {
     }
 
     void Div::setWidthPercent(float widthPercent) {
-        YGNodeStyleSetWidthPercent(_yogaNode, YogaPercent(widthPercent));
+        syncWidth(YogaPercent(widthPercent), true);
     }
 
     float Div::getHeightPercent() const {
@@ -471,7 +515,7 @@ namespace psychic_ui {
     }
 
     void Div::setHeightPercent(float heightPercent) {
-        YGNodeStyleSetHeightPercent(_yogaNode, YogaPercent(heightPercent));
+        syncHeight(YogaPercent(heightPercent), true);
     }
 
     // endregion
@@ -499,6 +543,78 @@ namespace psychic_ui {
         return _inlineStyle.get();
     }
 
+    Div *Div::animate(const ColorProperty property, const Color value, const std::chrono::microseconds duration, const Easing easing) {
+        if (_computedStyle && _computedStyle->has(property) && duration.count() > 0 && window()) {
+            Transition timing{};
+            timing.type     = Transition::Type::Color;
+            timing.property = property;
+            timing.duration = duration;
+            timing.easing   = easing;
+            Animator::getInstance().animate(this, property, _computedStyle->get(property), value, timing);
+            _animated = true;
+        }
+        // The restyle that follows keeps the animation running since it goes to the same value
+        _inlineStyle->set(property, value);
+        return this;
+    }
+
+    Div *Div::animate(const FloatProperty property, const float value, const std::chrono::microseconds duration, const Easing easing) {
+        if (_computedStyle && _computedStyle->has(property) && !std::isnan(_computedStyle->get(property))
+            && !std::isnan(value) && duration.count() > 0 && window()) {
+            Transition timing{};
+            timing.type     = Transition::Type::Float;
+            timing.property = property;
+            timing.duration = duration;
+            timing.easing   = easing;
+            Animator::getInstance().animate(this, property, _computedStyle->get(property), value, timing);
+            _animated = true;
+        }
+        _inlineStyle->set(property, value);
+        return this;
+    }
+
+    Div::Batch::Batch(Div *div) :
+        _div(div) {
+        _div->beginBatch();
+    }
+
+    Div::Batch::~Batch() {
+        _div->endBatch();
+    }
+
+    void Div::beginBatch() {
+        ++_batchDepth;
+    }
+
+    void Div::endBatch() {
+        assert(_batchDepth > 0);
+        if (--_batchDepth > 0) {
+            return;
+        }
+        if (_batchedLayout.edges != 0 || _batchedLayout.hasWidth || _batchedLayout.hasHeight) {
+            for (int edge = YGEdgeLeft; edge <= YGEdgeBottom; ++edge) {
+                if (_batchedLayout.edges & (1 << edge)) {
+                    syncPosition(static_cast<YGEdge>(edge), _batchedLayout.position[edge]);
+                }
+            }
+            if (_batchedLayout.hasWidth) {
+                syncWidth(_batchedLayout.width, _batchedLayout.widthPercent);
+            }
+            if (_batchedLayout.hasHeight) {
+                syncHeight(_batchedLayout.height, _batchedLayout.heightPercent);
+            }
+            _batchedLayout = BatchedLayout{};
+        }
+        if (_batchInvalidatedStyle) {
+            _batchInvalidatedStyle = false;
+            invalidateStyle();
+        }
+    }
+
+    bool Div::batching() const {
+        return _batchDepth > 0;
+    }
+
     const Style *Div::computedStyle() const {
         return _computedStyle.get();
     }
@@ -579,27 +695,196 @@ namespace psychic_ui {
         for (auto &child: _children) {
             child->updateRuntimeStyles();
         }
+        invalidateRenderCache();
     }
 
     void Div::invalidateStyle() {
         if (_styleDirty) {
             return;
         }
+        if (_batchDepth > 0) {
+            _batchInvalidatedStyle = true;
+            return;
+        }
         _styleDirty = true;
+        if (_parent && _parent->_styleDirty) {
+            // Ancestors were already taken care of by the parent
+            _renderCache.reset();
+            _scrollContent.reset();
+        } else {
+            invalidateRenderCache();
+        }
         for (const auto &child: _children) {
             child->invalidateStyle();
         }
     }
 
+    void Div::resetState() {
+        Animator::getInstance().cancel(this);
+        _animated      = false;
+        _computedStyle = std::make_unique<Style>();
+        _mouseOver     = false;
+        _mouseDown     = false;
+        _renderCache.reset();
+        _scrollContent.reset();
+        _styleDirty = true;
+        for (const auto &child: _children) {
+            child->resetState();
+        }
+    }
+
     void Div::updateStyle() {
         if (auto sm = styleManager()) {
+            PSYCHIC_PROFILE_COUNT(Restyles);
+            auto previous = std::move(_computedStyle);
             _computedStyle = sm->computeStyle(this);
+            startTransitions(previous.get());
             updateLayout();
             _styleDirty = false;
+            _renderCache.reset();
+            _scrollContent.reset();
             styleUpdated();
         }
     }
 
+    namespace {
+        bool animatable(const Color /*value*/) {
+            return true;
+        }
+
+        bool animatable(const float value) {
+            return !std::isnan(value);
+        }
+    }
+
+    void Div::startTransitions(const Style *previous) {
+        const std::string source = _computedStyle->get(transition);
+        if (source != _transitionSource) {
+            _transitionSource = source;
+            _transitions.clear();
+            StyleParser::parseTransitions(_transitionSource, _transitions);
+        }
+        if (!previous || (!_animated && _transitions.empty())) {
+            return;
+        }
+
+        // Detached trees are never ticked, they take their new values right away
+        bool     canAnimate = window() != nullptr;
+        Animator &animator  = Animator::getInstance();
+
+        auto transitionProperty = [this, previous, canAnimate, &animator](auto property) {
+            bool has = _computedStyle->has(property);
+            auto to  = _computedStyle->get(property);
+
+            decltype(to) running{};
+            if (_animated && animator.target(this, property, running)) {
+                if (has && running == to) {
+                    // Restyled while animating toward the same value, keep going from where it is
+                    _computedStyle->set(property, previous->get(property));
+                    return;
+                }
+                animator.cancel(this, property);
+            }
+
+            if (!canAnimate || !has || !previous->has(property)) {
+                return;
+            }
+            auto from = previous->get(property);
+            if (from == to || !animatable(from) || !animatable(to)) {
+                return;
+            }
+
+            // Later transitions win, like in CSS
+            for (auto it = _transitions.crbegin(); it != _transitions.crend(); ++it) {
+                if (it->applies(property)) {
+                    if (it->duration.count() > 0) {
+                        animator.animate(this, property, from, to, *it);
+                        _animated = true;
+                        _computedStyle->set(property, from);
+                    }
+                    return;
+                }
+            }
+        };
+
+        for (int property = ColorProperty::color; property <= ColorProperty::contentBackgroundColor; ++property) {
+            transitionProperty(static_cast<ColorProperty>(property));
+        }
+        for (int property = FloatProperty::flex; property <= FloatProperty::rotate; ++property) {
+            transitionProperty(static_cast<FloatProperty>(property));
+        }
+    }
+
+    void Div::setAnimatedValue(const ColorProperty property, const Color value) {
+        Color previous = _computedStyle->get(property);
+        if (previous == value) {
+            return;
+        }
+        _computedStyle->set(property, value);
+
+        for (const auto &child: _children) {
+            if (!child->_computedStyle
+                || !child->_computedStyle->has(property)
+                || child->_computedStyle->get(property) != previous) {
+                continue;
+            }
+            const InheritableValues inheritable = child->inheritableValues();
+            if (std::find(inheritable.colorInheritable.cbegin(), inheritable.colorInheritable.cend(), property)
+                != inheritable.colorInheritable.cend()) {
+                child->setAnimatedValue(property, value);
+            }
+        }
+
+        // Colors only change the paints, no need to go through yoga
+        styleUpdated();
+        invalidateRenderCache();
+    }
+
+    void Div::setAnimatedValue(const FloatProperty property, const float value) {
+        float previous = _computedStyle->get(property);
+        if (previous == value) {
+            return;
+        }
+        _computedStyle->set(property, value);
+
+        for (const auto &child: _children) {
+            if (!child->_computedStyle
+                || !child->_computedStyle->has(property)
+                || child->_computedStyle->get(property) != previous) {
+                continue;
+            }
+            const InheritableValues inheritable = child->inheritableValues();
+            if (std::find(inheritable.floatInheritable.cbegin(), inheritable.floatInheritable.cend(), property)
+                != inheritable.floatInheritable.cend()) {
+                child->setAnimatedValue(property, value);
+            }
+        }
+
+        styleUpdated();
+
+        if (property == FloatProperty::opacity
+            || (property >= FloatProperty::translateX && property <= FloatProperty::rotate)) {
+            // Composited around the cached content, only what is drawn around it is recorded again
+            // `styleUpdated()` already updated the ancestors' bounds for transforms
+            if (_parent) {
+                _parent->invalidateRenderCache();
+            } else if (Window *window = this->window()) {
+                window->requestFrame();
+            }
+            return;
+        }
+
+        bool paintOnly = property >= FloatProperty::borderRadius && property <= FloatProperty::borderRadiusBottomRight;
+        if (!paintOnly) {
+            updateLayout();
+            if (YGNodeGetMeasureFunc(_yogaNode)) {
+                // Measured content like text depends on the font properties
+                YGNodeMarkDirty(_yogaNode);
+            }
+        }
+        invalidateRenderCache();
+    }
+
     void Div::updateStyleRecursive() {
         updateStyle();
         if (_visible) {
@@ -609,6 +894,17 @@ namespace psychic_ui {
         }
     }
 
+    void Div::updateDirtyStyles() {
+        if (_styleDirty) {
+            updateStyle();
+        }
+        if (_visible) {
+            for (auto &child: _children) {
+                child->updateDirtyStyles();
+            }
+        }
+    }
+
     void Div::styleUpdated() {
         // region Visibility
         if (_computedStyle->has(visible)) {
@@ -616,6 +912,16 @@ namespace psychic_ui {
         }
         // endregion
 
+        // region Render Cache
+        _renderCacheEnabled = _computedStyle->get(renderCache);
+        _scrollLayerEnabled = _computedStyle->get(overflow) == "scroll"
+                              && (!_computedStyle->has(scrollLayer) || _computedStyle->get(scrollLayer));
+        if (!_scrollLayerEnabled) {
+            _scrollContent.reset();
+            _scrollLayer.reset();
+        }
+        // endregion
+
         // region Radius
         float tmp;
         if (_computedStyle->has(borderRadius)) {
@@ -687,6 +993,82 @@ namespace psychic_ui {
         _drawBackground = _computedStyle->has(backgroundColor)
                           && (_computedStyle->get(backgroundColor) != 0x00000000);
         // endregion
+
+        // region Compositing
+        _opacity = _computedStyle->has(opacity)
+                   ? std::min(std::max(_computedStyle->get(opacity), 0.0f), 1.0f)
+                   : 1.0f;
+        if (updateTransform() && _parent) {
+            // Restyles don't always lay out again, ancestors composite and hit test within their bounds
+            for (Div *div = _parent; div && div->updateBounds(); div = div->_parent) {}
+            _parent->invalidateRenderCache();
+        }
+        // endregion
+    }
+
+    bool Div::updateTransform() {
+        bool     wasTransformed = _transformed;
+        SkMatrix previous       = _transform;
+
+        float translationX = _computedStyle->has(translateX) ? _computedStyle->get(translateX) : 0.0f;
+        float translationY = _computedStyle->has(translateY) ? _computedStyle->get(translateY) : 0.0f;
+        float uniformScale = _computedStyle->has(scale) ? _computedStyle->get(scale) : 1.0f;
+        float scaleH       = (_computedStyle->has(scaleX) ? _computedStyle->get(scaleX) : 1.0f) * uniformScale;
+        float scaleV       = (_computedStyle->has(scaleY) ? _computedStyle->get(scaleY) : 1.0f) * uniformScale;
+        float rotation     = _computedStyle->has(rotate) ? _computedStyle->get(rotate) : 0.0f;
+
+        _transformed = translationX != 0.0f || translationY != 0.0f || scaleH != 1.0f || scaleV != 1.0f || rotation != 0.0f;
+        if (!_transformed) {
+            _transform.reset();
+            _inverseTransform.reset();
+            _transformInvertible = true;
+            return wasTransformed;
+        }
+
+        float cx = _rect.centerX();
+        float cy = _rect.centerY();
+        _transform.setTranslate(-cx, -cy);
+        _transform.postScale(scaleH, scaleV);
+        _transform.postRotate(rotation);
+        _transform.postTranslate(cx + translationX, cy + translationY);
+        _transformInvertible = _transform.invert(&_inverseTransform);
+        return !wasTransformed || _transform != previous;
+    }
+
+    bool Div::updateBounds() {
+        _boundsLeft   = _x;
+        _boundsTop    = _y;
+        _boundsRight  = _x + _width;
+        _boundsBottom = _y + _height;
+        for (auto &child: _children) {
+            SkRect childBounds = child->_boundsRect;
+            if (child->_transformed) {
+                child->_transform.mapRect(&childBounds);
+            }
+            _boundsLeft   = std::min(_boundsLeft, _x + (int) std::floor(childBounds.left()));
+            _boundsTop    = std::min(_boundsTop, _y + (int) std::floor(childBounds.top()));
+            _boundsRight  = std::max(_boundsRight, _x + (int) std::ceil(childBounds.right()));
+            _boundsBottom = std::max(_boundsBottom, _y + (int) std::ceil(childBounds.bottom()));
+        }
+        SkRect previousBoundsRect = _boundsRect;
+        _boundsRect.set(_boundsLeft, _boundsTop, _boundsRight, _boundsBottom);
+        return previousBoundsRect != _boundsRect;
+    }
+
+    void Div::untransform(int &x, int &y) const {
+        if (!_transformed) {
+            return;
+        }
+        if (!_transformInvertible) {
+            // Scaled down to nothing, there is nothing left to hit
+            x = std::numeric_limits<int>::min() / 2;
+            y = std::numeric_limits<int>::min() / 2;
+            return;
+        }
+        SkPoint point;
+        _inverseTransform.mapXY(x, y, &point);
+        x = (int) std::lround(point.x());
+        y = (int) std::lround(point.y());
     }
 
     // endregion
@@ -695,11 +1077,12 @@ namespace psychic_ui {
 
     void Div::invalidate() {
         YGNodeMarkDirty(_yogaNode);
+        invalidateRenderCache();
         //std::cout << "Mark dirty" << std::endl;
     }
 
     bool Div::isValid() const {
-        std::cout << "Is dirty: " << (YGNodeIsDirty(_yogaNode) ? "Yes" : "No") << std::endl;
+        PSYCHIC_LOG_TRACE("Is dirty: " << (YGNodeIsDirty(_yogaNode) ? "Yes" : "No"));
         return !YGNodeIsDirty(_yogaNode);
     }
 
@@ -710,9 +1093,10 @@ namespace psychic_ui {
                 YGSize size{};
                 auto   div = static_cast<Div *>(YGNodeGetContext(node));
                 if (!div) {
-                    std::cerr << "Could not find div to measure" << std::endl;
+                    PSYCHIC_LOG_ERROR("Could not find div to measure");
                     return size;
                 }
+                PSYCHIC_PROFILE_COUNT(Measures);
                 return div->measure(width, widthMode, height, heightMode);
             }
         );
@@ -852,12 +1236,22 @@ namespace psychic_ui {
         }
     }
 
+    std::mutex &Div::layoutMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
     void Div::layoutUpdated() {
         if (!YGNodeGetHasNewLayout(_yogaNode)) {
             return;
         }
 
         YGNodeSetHasNewLayout(_yogaNode, false);
+        PSYCHIC_PROFILE_COUNT(LayoutUpdates);
+
+        // Ancestors also have a new layout, they'll drop their own cache
+        _renderCache.reset();
+        _scrollContent.reset();
 
         _x = (int) std::ceil(YGNodeLayoutGetLeft(_yogaNode));
         _y = (int) std::ceil(YGNodeLayoutGetTop(_yogaNode));
@@ -888,7 +1282,7 @@ namespace psychic_ui {
         _borderRight  = YGNodeLayoutGetBorder(_yogaNode, YGEdgeRight);
         _borderBottom = YGNodeLayoutGetBorder(_yogaNode, YGEdgeBottom);
 
-        std::cout << _borderLeft << " " << _borderTop << " " << _borderRight << " " << _borderBottom << std::endl;
+        PSYCHIC_LOG_TRACE("Borders: " << _borderLeft << " " << _borderTop << " " << _borderRight << " " << _borderBottom);
 
         _paddedRect.set(
             _x + YGNodeLayoutGetPadding(_yogaNode, YGEdgeLeft) + _borderLeft,
@@ -909,25 +1303,18 @@ namespace psychic_ui {
         );
 
 
+        // The transform turns around the center
+        updateTransform();
+
         // Children should also update
-        _boundsLeft   = _x;
-        _boundsTop    = _y;
-        _boundsRight  = _x + _width;
-        _boundsBottom = _y + _height;
         for (auto &child: _children) {
             child->layoutUpdated();
-
-            _boundsLeft   = std::min(_boundsLeft, _x + child->boundsLeft());
-            _boundsTop    = std::min(_boundsTop, _y + child->boundsTop());
-            _boundsRight  = std::max(_boundsRight, _x + child->boundsRight());
-            _boundsBottom = std::max(_boundsBottom, _y + child->boundsBottom());
         }
-        SkRect previousBoundsRect = _boundsRect;
-        _boundsRect.set(_boundsLeft, _boundsTop, _boundsRight, _boundsBottom);
+        bool boundsChanged = updateBounds();
 
         layoutReady = true;
 
-        if (previousWidth != _width || previousHeight != _height || previousBoundsRect != _boundsRect) {
+        if (previousWidth != _width || previousHeight != _height || boundsChanged) {
             onResized(_width, _height);
         }
     }
@@ -946,10 +1333,44 @@ namespace psychic_ui {
             updateStyle();
         }
 
-        if (!layoutReady || !_visible || canvas->quickReject(_rect)) {
+        if (!layoutReady || !_visible || _opacity <= 0.0f) {
             return;
         }
 
+        // Compositing wraps the cache, changing it doesn't record the div again
+        int saveCount = canvas->getSaveCount();
+        if (_transformed) {
+            canvas->save();
+            canvas->concat(_transform);
+        }
+
+        if (!canvas->quickReject(_rect)) {
+            if (_opacity < 1.0f) {
+                canvas->saveLayerAlpha(&_boundsRect, (U8CPU) std::lround(_opacity * 255.0f));
+            }
+
+            bool useRenderCache = _renderCacheEnabled;
+            #ifdef DEBUG_LAYOUT
+            useRenderCache = useRenderCache && !debugLayout;
+            #endif
+
+            if (!useRenderCache) {
+                _renderCache.reset();
+                renderContent(canvas);
+            } else {
+                if (!_renderCache) {
+                    SkPictureRecorder recorder;
+                    renderContent(recorder.beginRecording(_boundsRect));
+                    _renderCache = recorder.finishRecordingAsPicture();
+                }
+                canvas->drawPicture(_renderCache);
+            }
+        }
+
+        canvas->restoreToCount(saveCount);
+    }
+
+    void Div::renderContent(SkCanvas *canvas) {
         canvas->save();
 
         draw(canvas);
@@ -1014,13 +1435,166 @@ namespace psychic_ui {
 
         canvas->translate(_x, _y);
 
+        if (_scrollLayerEnabled) {
+            renderScrollLayer(canvas);
+        } else {
+            renderChildren(canvas);
+        }
+
+        canvas->restore();
+    }
+
+    void Div::renderChildren(SkCanvas *canvas) {
         // This is the only place where we iterate in reverse because we order children in reverse in the vector
         // as to not explode when we modify children in event handlers. We still need to render back-to-front though ;)
         for (auto child = _children.rbegin(); child != _children.rend(); ++child) {
             (*child)->render(canvas);
         }
+    }
 
-        canvas->restore();
+    void Div::renderScrollLayer(SkCanvas *canvas) {
+        // Everything here is in content coordinates, the canvas is already translated by the scroll offset
+        SkIRect contentRect = SkIRect::MakeLTRB(_boundsLeft - _x, _boundsTop - _y, _boundsRight - _x, _boundsBottom - _y);
+
+        if (!_scrollContent) {
+            SkRTreeFactory    factory;
+            SkPictureRecorder recorder;
+            renderChildren(recorder.beginRecording(SkRect::Make(contentRect), &factory));
+            _scrollContent = recorder.finishRecordingAsPicture();
+            _scrollLayer.reset();
+        }
+
+        SkIRect visibleRect = SkIRect::MakeXYWH(-_scrollX, -_scrollY, _width, _height);
+        if (!visibleRect.intersect(contentRect)) {
+            return;
+        }
+
+        // Rasterized layers can only be blitted as-is, let the picture deal with anything else
+        if (!canvas->getTotalMatrix().isTranslate()) {
+            canvas->drawPicture(_scrollContent);
+            return;
+        }
+
+        if (!_scrollLayer || !_scrollLayerRect.contains(visibleRect)) {
+            // When the content changed only the visible area is rasterized, children that keep
+            // changing would otherwise pay for the margin every frame. When scrolling gets out of
+            // the layer, half a viewport of margin is added along the axes that scroll, so that
+            // scrolling only moves the layer until it gets out of the margin.
+            SkIRect layerRect = visibleRect;
+            if (_scrollLayer) {
+                layerRect.outset(
+                    contentRect.width() > visibleRect.width() ? _width / 2 : 0,
+                    contentRect.height() > visibleRect.height() ? _height / 2 : 0
+                );
+                layerRect.intersect(contentRect);
+            }
+
+            auto surface = canvas->makeSurface(SkImageInfo::MakeN32Premul(layerRect.width(), layerRect.height()));
+            if (!surface) {
+                // Recording canvas or no backing store, can't have a layer
+                canvas->drawPicture(_scrollContent);
+                return;
+            }
+
+            SkCanvas *layerCanvas = surface->getCanvas();
+            layerCanvas->clear(SK_ColorTRANSPARENT);
+            layerCanvas->translate(-layerRect.left(), -layerRect.top());
+            layerCanvas->drawPicture(_scrollContent);
+            _scrollLayer     = surface->makeImageSnapshot();
+            _scrollLayerRect = layerRect;
+        }
+
+        canvas->drawImage(_scrollLayer, _scrollLayerRect.left(), _scrollLayerRect.top());
+    }
+
+    sk_sp<SkImage> Div::renderToImage(const float scale, GrContext *context) {
+        if (!window() && (!layoutReady || _styleDirty || YGNodeIsDirty(_yogaNode))) {
+            layoutDetached();
+        }
+        if (!layoutReady || _width <= 0 || _height <= 0 || scale <= 0.0f) {
+            return nullptr;
+        }
+
+        SkImageInfo info = SkImageInfo::MakeN32Premul(
+            (int) std::ceil(_width * scale),
+            (int) std::ceil(_height * scale)
+        );
+        sk_sp<SkSurface> surface = context
+                                   ? SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info)
+                                   : SkSurface::MakeRaster(info);
+        if (!surface) {
+            PSYCHIC_LOG_ERROR("Could not create a " << _width << "x" << _height << " surface to render into");
+            return nullptr;
+        }
+
+        PSYCHIC_PROFILE_SCOPE("renderToImage");
+        SkCanvas *canvas = surface->getCanvas();
+        canvas->clear(0x00000000);
+        canvas->scale(scale, scale);
+        // Our rect is in our parent's coordinates
+        canvas->translate(-_x, -_y);
+        render(canvas);
+        return surface->makeImageSnapshot();
+    }
+
+    void Div::layoutDetached(const float width, const float height) {
+        if (window()) {
+            PSYCHIC_LOG_WARNING("Divs in a window are laid out by their window");
+            return;
+        }
+        if (!styleManager()) {
+            setStyleManager(StyleManager::getInstance());
+        }
+
+        updateDirtyStyles();
+        {
+            PSYCHIC_PROFILE_SCOPE("layout");
+            std::lock_guard<std::mutex> lock(layoutMutex());
+            YGNodeCalculateLayout(_yogaNode, width, height, YGDirectionLTR);
+        }
+        layoutUpdated();
+    }
+
+    std::future<sk_sp<SkImage>> Div::renderToImageAsync(std::shared_ptr<Div> root, const float width, const float height, const float scale) {
+        if (root->window()) {
+            throw std::runtime_error("Only detached trees can be rendered on a background thread");
+        }
+        // The main thread keeps using the manager, the other thread styles against a private copy
+        std::shared_ptr<StyleManager> manager = root->_styleManager ? root->_styleManager : StyleManager::getInstance();
+        root->setStyleManager(manager->snapshot());
+
+        return std::async(
+            std::launch::async, [root, manager, width, height, scale]() {
+                root->layoutDetached(width, height);
+                sk_sp<SkImage> image = root->renderToImage(scale);
+                // The tree is ours until the image is handed over
+                root->_styleManager = manager;
+                return image;
+            }
+        );
+    }
+
+    void Div::invalidateRenderCache() {
+        Div *root = this;
+        for (Div *div = this; div != nullptr; div = div->_parent) {
+            div->_renderCache.reset();
+            div->_scrollContent.reset();
+            root = div;
+        }
+        // Only windows are drawn again when something changed
+        if (Window *window = root->window()) {
+            window->requestFrame();
+        }
+    }
+
+    void Div::scrollChanged() {
+        // The scrolled content itself didn't change, only the way it is composited
+        _renderCache.reset();
+        if (_parent) {
+            _parent->invalidateRenderCache();
+        } else if (Window *window = this->window()) {
+            window->requestFrame();
+        }
     }
 
     void Div::clip(SkCanvas *canvas) {
@@ -1050,9 +1624,6 @@ namespace psychic_ui {
             paint.setStyle(SkPaint::kFill_Style);
             paint.setColor(_computedStyle->get(backgroundColor));
             paint.setAntiAlias(_computedStyle->get(antiAlias));
-            if (_computedStyle->has(opacity)) {
-                paint.setAlpha((unsigned int) (_computedStyle->get(opacity) * 255.f));
-            }
 
             float hb = _computedStyle->get(border) / 2;
             if (_drawComplexRoundRect) {
@@ -1235,7 +1806,8 @@ namespace psychic_ui {
 
     // region Buttons
 
-    MouseEventStatus Div::mouseButton(const int mouseX, const int mouseY, const MouseButton button, const bool down, const Mod modifiers) {
+    MouseEventStatus Div::mouseButton(int mouseX, int mouseY, const MouseButton button, const bool down, const Mod modifiers) {
+        untransform(mouseX, mouseY);
         if (!_visible || !boundsContains(mouseX, mouseY)) {
             return Out;
         }
@@ -1262,7 +1834,8 @@ namespace psychic_ui {
         return ret == Out ? Over : ret;
     }
 
-    MouseEventStatus Div::mouseDown(const int mouseX, const int mouseY, const MouseButton button, const Mod modifiers) {
+    MouseEventStatus Div::mouseDown(int mouseX, int mouseY, const MouseButton button, const Mod modifiers) {
+        untransform(mouseX, mouseY);
         if (!_visible || !boundsContains(mouseX, mouseY)) {
             return Out;
         }
@@ -1297,7 +1870,8 @@ namespace psychic_ui {
         return ret == Handled || onClick.hasSubscriptions() ? Handled : Over;
     }
 
-    MouseEventStatus Div::mouseUp(const int mouseX, const int mouseY, const MouseButton button, const Mod modifiers) {
+    MouseEventStatus Div::mouseUp(int mouseX, int mouseY, const MouseButton button, const Mod modifiers) {
+        untransform(mouseX, mouseY);
         if (!_visible) {
             return Out;
         }
@@ -1340,7 +1914,8 @@ namespace psychic_ui {
         return ret == Out ? Over : ret;
     }
 
-    MouseEventStatus Div::click(const int mouseX, const int mouseY, const MouseButton button, const Mod modifiers) {
+    MouseEventStatus Div::click(int mouseX, int mouseY, const MouseButton button, const Mod modifiers) {
+        untransform(mouseX, mouseY);
         if (!_visible || !boundsContains(mouseX, mouseY)) {
             return Out;
         }
@@ -1371,7 +1946,8 @@ namespace psychic_ui {
         return ret == Out ? Over : ret;
     }
 
-    MouseEventStatus Div::doubleClick(const int mouseX, const int mouseY, const unsigned int clickCount, const Mod modifiers) {
+    MouseEventStatus Div::doubleClick(int mouseX, int mouseY, const unsigned int clickCount, const Mod modifiers) {
+        untransform(mouseX, mouseY);
         if (!_visible || !boundsContains(mouseX, mouseY)) {
             return Out;
         }
@@ -1428,7 +2004,8 @@ namespace psychic_ui {
         return true;
     }
 
-    MouseEventStatus Div::mouseMoved(const int mouseX, const int mouseY, const int buttons, const Mod modifiers, bool handled) {
+    MouseEventStatus Div::mouseMoved(int mouseX, int mouseY, const int buttons, const Mod modifiers, bool handled) {
+        untransform(mouseX, mouseY);
         if (!_visible) {
             return Out;
         }
@@ -1516,11 +2093,13 @@ namespace psychic_ui {
         }
 
         if (scrolled) {
+            scrollChanged();
             onScrolled(_scrollX, _scrollY);
         }
     }
 
-    MouseEventStatus Div::mouseScrolled(const int mouseX, const int mouseY, const double scrollX, const double scrollY) {
+    MouseEventStatus Div::mouseScrolled(int mouseX, int mouseY, const double scrollX, const double scrollY) {
+        untransform(mouseX, mouseY);
         if (!_visible || !boundsContains(mouseX, mouseY)) {
             return Out;
         }
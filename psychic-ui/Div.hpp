@@ -1,6 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <mutex>
 
 #include <vector>
 #include <unordered_set>
@@ -8,11 +12,17 @@
 #include <unicode/unistr.h>
 #include <SkCanvas.h>
 #include <SkRRect.h>
+#include <SkPicture.h>
+#include <SkImage.h>
 #include "psychic-ui.hpp"
 #include "psychic-ui/style/Style.hpp"
 #include "psychic-ui/style/StyleManager.hpp"
+#include "psychic-ui/style/Transition.hpp"
 #include "psychic-ui/signals/Signal.hpp"
 #include "psychic-ui/signals/Observer.hpp"
+#include "psychic-ui/utils/Pool.hpp"
+
+class GrContext;
 
 namespace psychic_ui {
 
@@ -72,6 +82,8 @@ namespace psychic_ui {
 
         friend class Modal;
 
+        friend class Animator;
+
     public:
         Div();
 
@@ -154,6 +166,7 @@ namespace psychic_ui {
 
         /**
          * Construct a child from type T and add it at the same time
+         * With pool allocation enabled, children of each type are drawn from their own pool.
          * @tparam T Type of the child to add
          * @tparam Args
          * @param args Arguments to pass to the child's constructor
@@ -161,7 +174,11 @@ namespace psychic_ui {
          */
         template<typename T, typename... Args>
         std::shared_ptr<T> add(Args &&... args) {
+            #ifdef PSYCHIC_UI_POOL_ALLOCATION
+            return std::static_pointer_cast<T>(add(makePooled<T>(std::forward<Args>(args)...)));
+            #else
             return std::static_pointer_cast<T>(add(std::make_shared<T>(std::forward<Args>(args)...)));
+            #endif
         }
 
         /**
@@ -305,6 +322,7 @@ namespace psychic_ui {
         Div *setScrollX(const int &scrollX) {
             if (scrollX != _scrollX) {
                 _scrollX = scrollX;
+                scrollChanged();
                 onScrolled(_scrollX, _scrollY);
             }
             return this;
@@ -317,6 +335,7 @@ namespace psychic_ui {
         Div *setScrollY(const int &scrollY) {
             if (scrollY != _scrollY) {
                 _scrollY = scrollY;
+                scrollChanged();
                 onScrolled(_scrollX, _scrollY);
             }
             return this;
@@ -346,6 +365,51 @@ namespace psychic_ui {
          */
         Style *style() const;
 
+        /**
+         * Animate a property from its current value to a new one
+         * The new value is set in the inline style, where it stays once the animation is over.
+         * Divs that aren't in an open window take the new value right away.
+         */
+        Div *animate(ColorProperty property, Color value, std::chrono::microseconds duration, Easing easing = Easing::Ease);
+        Div *animate(FloatProperty property, float value, std::chrono::microseconds duration, Easing easing = Easing::Ease);
+
+        /**
+         * @class Batch
+         *
+         * Scoped guard holding the invalidation of a div until it goes out of scope.
+         * Inline style changes, tag, id and class name changes made while the batch is held
+         * invalidate the div (and its children) only once, when the outermost batch ends.
+         * Geometry setters (position and dimensions) are written to the yoga node at that
+         * point too, so the layout is only invalidated once:
+         *
+         *     {
+         *         Div::Batch batch{div};
+         *         div->setSize(100, 100);
+         *         div->style()->set(backgroundColor, 0xFF000000);
+         *         div->addClassName("selected");
+         *     }
+         *
+         * Geometry getters reading from yoga return the committed values until then.
+         */
+        class Batch {
+        public:
+            explicit Batch(Div *div);
+            ~Batch();
+            Batch(const Batch &) = delete;
+            Batch &operator=(const Batch &) = delete;
+
+        protected:
+            Div *_div;
+        };
+
+        /**
+         * Hold the style invalidation, prefer the scoped `Batch` guard
+         * Calls can be nested, the held invalidation happens on the last `endBatch()`.
+         */
+        void beginBatch();
+        void endBatch();
+        bool batching() const;
+
         /**
          * Get the current style manager
          * In order of importance, the local override, the parent's (until window) or the singleton
@@ -364,6 +428,11 @@ namespace psychic_ui {
         void updateStyle();
         void updateStyleRecursive();
 
+        /**
+         * Restyle the divs of the subtree whose style was invalidated
+         */
+        void updateDirtyStyles();
+
         /**
          * Get the computed style
          * @return
@@ -384,7 +453,40 @@ namespace psychic_ui {
 
         // region Rendering
 
+        /**
+         * Drop the recorded rendering of this div and of its ancestors
+         * Has to be called by divs whose drawing changes without going
+         * through a style or layout invalidation.
+         */
+        void invalidateRenderCache();
+
+        /**
+         * Render the div and its children into an image
+         * Divs in a window are rendered with their current layout, from the main thread.
+         * Detached trees are restyled and laid out first if needed, at the size
+         * given by their style. Render caches are reused.
+         * @param scale Scale of the image, e.g. 0.25 for a quarter size thumbnail
+         * @param context Skia context to render on the GPU with, from its thread, renders in memory when null
+         * @return Rendered image, nullptr if the div has no size
+         */
+        sk_sp<SkImage> renderToImage(float scale = 1.0f, GrContext *context = nullptr);
 
+        /**
+         * Restyle and lay out a tree that isn't in a window, to render it offscreen
+         * Uses the application's style manager if the tree doesn't have one.
+         * @param width Layout width, YGUndefined to let the tree size itself
+         * @param height Layout height, YGUndefined to let the tree size itself
+         */
+        void layoutDetached(float width = YGUndefined, float height = YGUndefined);
+
+        /**
+         * Lay out and render a detached tree into a raster image on a background thread
+         * The tree must not be touched until the image is ready. It is styled against a snapshot
+         * of its style manager, taken by this call, so the manager can keep changing meanwhile.
+         */
+        static std::future<sk_sp<SkImage>> renderToImageAsync(
+            std::shared_ptr<Div> root, float width = YGUndefined, float height = YGUndefined, float scale = 1.0f
+        );
 
         // endregion
 
@@ -504,8 +606,8 @@ namespace psychic_ui {
         /**
          * Internal Id
          */
-        static int  idCounter;
-        std::string _internalId{};
+        static std::atomic<int> idCounter;
+        std::string             _internalId{};
 
         /**
          * Id
@@ -546,12 +648,95 @@ namespace psychic_ui {
          */
         bool _styleDirty{true};
 
+        /**
+         * Transitions of the computed style, parsed again only when the `transition` property changes
+         */
+        std::string             _transitionSource{};
+        std::vector<Transition> _transitions{};
+
+        /**
+         * Whether the Animator may have animations running for this div
+         */
+        bool _animated{false};
+
+        /**
+         * Start the transitions of the properties that changed from the previous computed style
+         * The computed style keeps showing the previous values, the Animator takes it from there.
+         */
+        void startTransitions(const Style *previous);
+
+        /**
+         * Write an animated value into the computed style, without restyling
+         * Children that inherited the previous value follow.
+         */
+        void setAnimatedValue(ColorProperty property, Color value);
+        void setAnimatedValue(FloatProperty property, float value);
+
+        /**
+         * Geometry set while batching, only the latest value of each edge and dimension is kept
+         */
+        struct BatchedLayout {
+            float   position[4]{};
+            uint8_t edges{0};
+            float   width{0.0f};
+            float   height{0.0f};
+            bool    hasWidth{false};
+            bool    hasHeight{false};
+            bool    widthPercent{false};
+            bool    heightPercent{false};
+        };
+
+        /**
+         * Batch depth and whether the style was invalidated while batching
+         */
+        unsigned int  _batchDepth{0};
+        bool          _batchInvalidatedStyle{false};
+        BatchedLayout _batchedLayout{};
+
+        /**
+         * Write geometry to the yoga node, or hold it until the outermost batch ends
+         * @param edge One of left, top, right or bottom
+         */
+        void syncPosition(const YGEdge edge, const float value) {
+            if (_batchDepth == 0) {
+                YGNodeStyleSetPosition(_yogaNode, edge, value);
+            } else {
+                _batchedLayout.position[edge] = value;
+                _batchedLayout.edges |= 1 << edge;
+            }
+        }
+
+        void syncWidth(const float value, const bool percent = false) {
+            if (_batchDepth == 0) {
+                percent ? YGNodeStyleSetWidthPercent(_yogaNode, value) : YGNodeStyleSetWidth(_yogaNode, value);
+            } else {
+                _batchedLayout.width        = value;
+                _batchedLayout.hasWidth     = true;
+                _batchedLayout.widthPercent = percent;
+            }
+        }
+
+        void syncHeight(const float value, const bool percent = false) {
+            if (_batchDepth == 0) {
+                percent ? YGNodeStyleSetHeightPercent(_yogaNode, value) : YGNodeStyleSetHeight(_yogaNode, value);
+            } else {
+                _batchedLayout.height        = value;
+                _batchedLayout.hasHeight     = true;
+                _batchedLayout.heightPercent = percent;
+            }
+        }
 
         /**
          * Invalidate the style
          */
         void invalidateStyle();
 
+        /**
+         * Drop the style, animations and mouse state this subtree got where it was attached,
+         * it restyles from scratch, without transitions, once added somewhere else
+         */
+        void resetState();
+
         /**
          * Update the runtime style rules
          */
@@ -628,6 +813,11 @@ namespace psychic_ui {
          */
         void updateLayout();
 
+        /**
+         * Yoga keeps its layout generation in globals, trees are laid out one at a time
+         */
+        static std::mutex &layoutMutex();
+
         /**
          * Callback for when layout was updated
          */
@@ -643,9 +833,63 @@ namespace psychic_ui {
         bool isValid() const;
         virtual YGSize measure(float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode);
         virtual void render(SkCanvas *canvas);
+        void renderContent(SkCanvas *canvas);
+        void renderChildren(SkCanvas *canvas);
+        void renderScrollLayer(SkCanvas *canvas);
+        void scrollChanged();
         void clip(SkCanvas *canvas);
         virtual void draw(SkCanvas *canvas);
 
+        /**
+         * Whether the rendering of this div and its children is recorded
+         * and replayed until something in the subtree changes
+         */
+        bool             _renderCacheEnabled{false};
+        sk_sp<SkPicture> _renderCache{nullptr};
+
+        /**
+         * Scrollable divs keep their children recorded in a picture and rasterized
+         * in a layer, scrolling only moves the layer around until it gets out of it
+         */
+        bool             _scrollLayerEnabled{false};
+        sk_sp<SkPicture> _scrollContent{nullptr};
+        sk_sp<SkImage>   _scrollLayer{nullptr};
+        SkIRect          _scrollLayerRect{};
+
+        /**
+         * Compositing, applied around the cached content of the div, changing it
+         * only redraws the ancestors and never lays anything out.
+         * Opacity fades the div and its children as a group in a layer, the transform
+         * is in the parent's coordinates and turns around the center of the div.
+         */
+        float    _opacity{1.0f};
+        bool     _transformed{false};
+        bool     _transformInvertible{true};
+        SkMatrix _transform{};
+        SkMatrix _inverseTransform{};
+
+        /**
+         * Rebuild the transform from the computed style and the layout
+         * @return Whether the transform changed
+         */
+        bool updateTransform();
+
+        /**
+         * Recompute the bounds from the children, including their transforms
+         * @return Whether the bounds changed
+         */
+        bool updateBounds();
+
+        /**
+         * Map a point from the parent's coordinates through the inverse transform
+         */
+        void untransform(int &x, int &y) const;
+
+        /**
+         * Matrix from the coordinates of the children to the window's
+         */
+        SkMatrix localToGlobalMatrix() const;
+
         bool _drawBackground{false};
         bool _drawBorder{false};
         bool _drawComplexBorders{false};
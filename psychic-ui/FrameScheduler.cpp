@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <thread>
+#include "FrameScheduler.hpp"
+
+namespace psychic_ui {
+
+    // region Pacing
+
+    FrameScheduler::Pacing FrameScheduler::pacing() const {
+        return _pacing;
+    }
+
+    void FrameScheduler::setPacing(const Pacing pacing) {
+        _pacing = pacing;
+    }
+
+    double FrameScheduler::targetRate() const {
+        return _targetRate;
+    }
+
+    void FrameScheduler::setTargetRate(const double framesPerSecond) {
+        _targetRate = framesPerSecond > 0.0 ? framesPerSecond : 60.0;
+    }
+
+    bool FrameScheduler::skipIdleFrames() const {
+        return _skipIdleFrames;
+    }
+
+    void FrameScheduler::setSkipIdleFrames(const bool skipIdleFrames) {
+        _skipIdleFrames = skipIdleFrames;
+    }
+
+    std::chrono::microseconds FrameScheduler::frameInterval() const {
+        return std::chrono::microseconds(static_cast<int64_t>(1000000.0 / _targetRate));
+    }
+
+    void FrameScheduler::frameStarted(const Clock::time_point now) {
+        auto interval = frameInterval();
+        _nextFrame += interval;
+        if (_nextFrame < now + interval / 2) {
+            // Late or idle for a while, start over from now instead of rushing to catch up
+            _nextFrame = now + interval;
+        }
+    }
+
+    FrameScheduler::Clock::time_point FrameScheduler::nextFrame() const {
+        return _nextFrame;
+    }
+
+    void FrameScheduler::pace() const {
+        if (_pacing == Pacing::FixedRate) {
+            sleepUntil(_nextFrame);
+        }
+    }
+
+    void FrameScheduler::sleepUntil(const Clock::time_point deadline) {
+        // OS sleeps can overshoot by a millisecond or more, only sleep while that is safe
+        const auto margin = std::chrono::milliseconds(2);
+        auto       now    = Clock::now();
+        if (deadline - now > margin) {
+            std::this_thread::sleep_until(deadline - margin);
+        }
+        while (Clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }
+
+    // endregion
+
+    // region Timers
+
+    FrameScheduler::TimerId FrameScheduler::setTimeout(const std::chrono::microseconds delay, std::function<void()> callback) {
+        TimerId id = _nextId++;
+        _timers.push_back({id, Clock::now() + delay, std::chrono::microseconds{0}, std::move(callback)});
+        return id;
+    }
+
+    FrameScheduler::TimerId FrameScheduler::setInterval(const std::chrono::microseconds interval, std::function<void()> callback) {
+        TimerId id = _nextId++;
+        _timers.push_back({id, Clock::now() + interval, std::max(interval, std::chrono::microseconds{1}), std::move(callback)});
+        return id;
+    }
+
+    void FrameScheduler::clearTimer(const TimerId id) {
+        for (auto &timer: _timers) {
+            if (timer.id == id) {
+                // Only marked here, timers can clear themselves while running
+                timer.callback = nullptr;
+            }
+        }
+    }
+
+    int FrameScheduler::runTimers(const Clock::time_point now) {
+        int run = 0;
+        // Timers added by the callbacks are appended and wait for the next frame
+        const std::size_t count = _timers.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!_timers[i].callback || _timers[i].due > now) {
+                continue;
+            }
+            // Copy, the callback can add timers and reallocate the list
+            auto callback = _timers[i].callback;
+            if (_timers[i].interval.count() > 0) {
+                _timers[i].due = std::max(_timers[i].due + _timers[i].interval, now);
+            } else {
+                _timers[i].callback = nullptr;
+            }
+            callback();
+            ++run;
+        }
+
+        _timers.erase(
+            std::remove_if(_timers.begin(), _timers.end(), [](const Timer &timer) { return !timer.callback; }),
+            _timers.end()
+        );
+        return run;
+    }
+
+    std::chrono::microseconds FrameScheduler::timeUntilNextTimer(const Clock::time_point now) const {
+        auto next = std::chrono::microseconds::max();
+        for (const auto &timer: _timers) {
+            if (!timer.callback) {
+                continue;
+            }
+            auto until = std::chrono::duration_cast<std::chrono::microseconds>(timer.due - now);
+            next = std::min(next, std::max(until, std::chrono::microseconds{0}));
+        }
+        return next;
+    }
+
+    // endregion
+
+    // region Frame Callbacks
+
+    FrameScheduler::TimerId FrameScheduler::addFrameCallback(std::function<bool(Clock::time_point)> callback) {
+        TimerId id = _nextId++;
+        _frameCallbacks.push_back({id, std::move(callback)});
+        return id;
+    }
+
+    void FrameScheduler::removeFrameCallback(const TimerId id) {
+        for (auto *callbacks: {&_frameCallbacks, &_runningFrameCallbacks}) {
+            for (auto &frameCallback: *callbacks) {
+                if (frameCallback.id == id) {
+                    frameCallback.callback = nullptr;
+                }
+            }
+        }
+    }
+
+    void FrameScheduler::runFrameCallbacks(const Clock::time_point now) {
+        // Swap so that callbacks added from inside the callbacks wait for the next frame
+        std::swap(_frameCallbacks, _runningFrameCallbacks);
+        for (auto &frameCallback: _runningFrameCallbacks) {
+            if (!frameCallback.callback) {
+                continue;
+            }
+            if (frameCallback.callback(now)) {
+                _frameCallbacks.push_back(std::move(frameCallback));
+            }
+        }
+        _runningFrameCallbacks.clear();
+    }
+
+    bool FrameScheduler::hasFrameCallbacks() const {
+        return std::any_of(
+            _frameCallbacks.cbegin(), _frameCallbacks.cend(),
+            [](const FrameCallback &frameCallback) { return frameCallback.callback != nullptr; }
+        );
+    }
+
+    // endregion
+
+}
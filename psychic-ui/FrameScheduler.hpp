@@ -0,0 +1,160 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace psychic_ui {
+
+    /**
+     * @class FrameScheduler
+     *
+     * Paces the main loop and runs the work that has to happen every frame.
+     *
+     * Every iteration of the main loop runs, in order: the timers that are due, the posted
+     * tasks within their budget, the frame callbacks and style animations, then input, style,
+     * layout, render and present for each window. With `setSkipIdleFrames(true)`, windows with
+     * nothing to update are not drawn at all, and when no window needs a frame the loop blocks
+     * waiting for events until the next timer is due.
+     *
+     * Frames are paced by waiting for the display refresh when vsync is enabled, or by sleeping
+     * until the next frame deadline at a fixed rate.
+     */
+    class FrameScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using TimerId = uint64_t;
+
+        enum class Pacing {
+            /**
+             * Draw as fast as possible
+             */
+            Unlimited,
+            /**
+             * Wait for the display refresh when presenting
+             */
+            VSync,
+            /**
+             * Sleep until the next frame deadline at `targetRate()` frames per second
+             */
+            FixedRate
+        };
+
+        // region Pacing
+
+        /**
+         * Frame pacing, unlimited by default
+         * Set it before opening windows since vsync is applied to their contexts.
+         */
+        Pacing pacing() const;
+        void setPacing(Pacing pacing);
+
+        double targetRate() const;
+        void setTargetRate(double framesPerSecond);
+
+        /**
+         * Only draw the windows that changed since their last frame, false by default
+         */
+        bool skipIdleFrames() const;
+        void setSkipIdleFrames(bool skipIdleFrames);
+
+        /**
+         * Time between two frames at the target rate
+         */
+        std::chrono::microseconds frameInterval() const;
+
+        /**
+         * Start a frame, moves the deadline of the next one
+         * Late frames don't build up a debt, the next deadline is at least half an interval away.
+         */
+        void frameStarted(Clock::time_point now = Clock::now());
+
+        Clock::time_point nextFrame() const;
+
+        /**
+         * Wait for the next frame deadline when pacing at a fixed rate
+         */
+        void pace() const;
+
+        /**
+         * Sleep until a deadline, with better precision than the OS sleep granularity
+         * Sleeps for most of the time then yields for the last stretch.
+         */
+        static void sleepUntil(Clock::time_point deadline);
+
+        // endregion
+
+        // region Timers
+
+        /**
+         * Call a function once after a delay, on the main loop
+         */
+        TimerId setTimeout(std::chrono::microseconds delay, std::function<void()> callback);
+
+        /**
+         * Call a function repeatedly, on the main loop
+         * Intervals shorter than a frame fire at most once per frame.
+         */
+        TimerId setInterval(std::chrono::microseconds interval, std::function<void()> callback);
+
+        void clearTimer(TimerId id);
+
+        /**
+         * Run the timers that are due
+         * @return Number of timers run
+         */
+        int runTimers(Clock::time_point now = Clock::now());
+
+        /**
+         * Time until the next timer is due, `std::chrono::microseconds::max()` if there is none
+         */
+        std::chrono::microseconds timeUntilNextTimer(Clock::time_point now = Clock::now()) const;
+
+        // endregion
+
+        // region Frame Callbacks
+
+        /**
+         * Call a function every frame until it returns false
+         * Custom animations go through here, the callback gets the frame time.
+         * Style transitions are run by the Animator, right after the frame callbacks.
+         */
+        TimerId addFrameCallback(std::function<bool(Clock::time_point)> callback);
+
+        void removeFrameCallback(TimerId id);
+
+        /**
+         * Run the frame callbacks, callbacks added meanwhile run on the next frame
+         */
+        void runFrameCallbacks(Clock::time_point now = Clock::now());
+
+        bool hasFrameCallbacks() const;
+
+        // endregion
+
+    protected:
+        struct Timer {
+            TimerId                   id{0};
+            Clock::time_point         due{};
+            std::chrono::microseconds interval{0};
+            std::function<void()>     callback{nullptr};
+        };
+
+        struct FrameCallback {
+            TimerId                                 id{0};
+            std::function<bool(Clock::time_point)> callback{nullptr};
+        };
+
+        Pacing            _pacing{Pacing::Unlimited};
+        double            _targetRate{60.0};
+        bool              _skipIdleFrames{false};
+        Clock::time_point _nextFrame{};
+
+        TimerId                    _nextId{1};
+        std::vector<Timer>         _timers{};
+        std::vector<FrameCallback> _frameCallbacks{};
+        std::vector<FrameCallback> _runningFrameCallbacks{};
+    };
+
+}
@@ -0,0 +1,133 @@
+#include "InputQueue.hpp"
+
+namespace psychic_ui {
+
+    // region Events
+
+    InputEvent InputEvent::mouseMove(const int mouseX, const int mouseY, const int buttons, const Mod modifiers) {
+        InputEvent event{};
+        event.type      = InputEventType::MouseMove;
+        event.mouseX    = mouseX;
+        event.mouseY    = mouseY;
+        event.buttons   = buttons;
+        event.modifiers = modifiers;
+        return event;
+    }
+
+    InputEvent InputEvent::mouseButton(const int mouseX, const int mouseY, const MouseButton button, const bool down, const Mod modifiers) {
+        InputEvent event{};
+        event.type      = InputEventType::MouseButton;
+        event.mouseX    = mouseX;
+        event.mouseY    = mouseY;
+        event.button    = button;
+        event.down      = down;
+        event.modifiers = modifiers;
+        return event;
+    }
+
+    InputEvent InputEvent::mouseScroll(const int mouseX, const int mouseY, const double scrollX, const double scrollY) {
+        InputEvent event{};
+        event.type    = InputEventType::MouseScroll;
+        event.mouseX  = mouseX;
+        event.mouseY  = mouseY;
+        event.scrollX = scrollX;
+        event.scrollY = scrollY;
+        return event;
+    }
+
+    InputEvent InputEvent::keyDown(const Key key, const Mod modifiers) {
+        InputEvent event{};
+        event.type      = InputEventType::KeyDown;
+        event.key       = key;
+        event.modifiers = modifiers;
+        return event;
+    }
+
+    InputEvent InputEvent::keyRepeat(const Key key, const Mod modifiers) {
+        InputEvent event{};
+        event.type      = InputEventType::KeyRepeat;
+        event.key       = key;
+        event.modifiers = modifiers;
+        return event;
+    }
+
+    InputEvent InputEvent::keyUp(const Key key, const Mod modifiers) {
+        InputEvent event{};
+        event.type      = InputEventType::KeyUp;
+        event.key       = key;
+        event.modifiers = modifiers;
+        return event;
+    }
+
+    InputEvent InputEvent::characterInput(const icu::UnicodeString &character) {
+        InputEvent event{};
+        event.type      = InputEventType::Character;
+        event.character = character;
+        return event;
+    }
+
+    InputEvent InputEvent::resize(const int width, const int height) {
+        InputEvent event{};
+        event.type   = InputEventType::Resize;
+        event.width  = width;
+        event.height = height;
+        return event;
+    }
+
+    // endregion
+
+    // region Queue
+
+    void InputQueue::push(InputEvent event) {
+        if (!_events.empty()) {
+            InputEvent &last = _events.back();
+            if (event.type == InputEventType::MouseMove
+                && last.type == InputEventType::MouseMove
+                && last.buttons == event.buttons
+                && sameModifiers(last.modifiers, event.modifiers)) {
+                // Only the latest position matters
+                last.mouseX = event.mouseX;
+                last.mouseY = event.mouseY;
+                return;
+            }
+
+            if (event.type == InputEventType::MouseScroll && last.type == InputEventType::MouseScroll) {
+                // Accumulate the deltas, at the latest position
+                last.mouseX = event.mouseX;
+                last.mouseY = event.mouseY;
+                last.scrollX += event.scrollX;
+                last.scrollY += event.scrollY;
+                return;
+            }
+        }
+
+        _events.push_back(std::move(event));
+    }
+
+    void InputQueue::drain(const std::function<void(const InputEvent &)> &dispatch) {
+        // Swap so that events queued from inside the handlers end up in the next frame
+        std::swap(_events, _dispatching);
+        for (const auto &event: _dispatching) {
+            dispatch(event);
+        }
+        _dispatching.clear();
+    }
+
+    void InputQueue::clear() {
+        _events.clear();
+    }
+
+    bool InputQueue::empty() const {
+        return _events.empty();
+    }
+
+    std::size_t InputQueue::size() const {
+        return _events.size();
+    }
+
+    bool InputQueue::sameModifiers(const Mod &a, const Mod &b) {
+        return a.shift == b.shift && a.ctrl == b.ctrl && a.alt == b.alt && a.super == b.super;
+    }
+
+    // endregion
+}
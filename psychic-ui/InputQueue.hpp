@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <unicode/unistr.h>
+#include "psychic-ui.hpp"
+
+namespace psychic_ui {
+
+    /**
+     * Types of input events that can go through the input queue
+     */
+    enum class InputEventType {
+        MouseMove,
+        MouseButton,
+        MouseScroll,
+        KeyDown,
+        KeyRepeat,
+        KeyUp,
+        Character,
+        Resize
+    };
+
+    /**
+     * Input event, as received from the system window backend
+     * Only the fields relevant to the event type are used.
+     */
+    struct InputEvent {
+        InputEventType     type{InputEventType::MouseMove};
+        int                mouseX{0};
+        int                mouseY{0};
+        int                buttons{0};
+        MouseButton        button{MouseButton::LEFT};
+        bool               down{false};
+        double             scrollX{0.0};
+        double             scrollY{0.0};
+        Key                key{Key::UNKNOWN};
+        Mod                modifiers{};
+        icu::UnicodeString character{};
+        int                width{0};
+        int                height{0};
+
+        /**
+         * When the backend received the event, merged events keep the oldest time
+         */
+        std::chrono::steady_clock::time_point received{};
+
+        static InputEvent mouseMove(int mouseX, int mouseY, int buttons, Mod modifiers);
+        static InputEvent mouseButton(int mouseX, int mouseY, MouseButton button, bool down, Mod modifiers);
+        static InputEvent mouseScroll(int mouseX, int mouseY, double scrollX, double scrollY);
+        static InputEvent keyDown(Key key, Mod modifiers);
+        static InputEvent keyRepeat(Key key, Mod modifiers);
+        static InputEvent keyUp(Key key, Mod modifiers);
+        static InputEvent characterInput(const icu::UnicodeString &character);
+        static InputEvent resize(int width, int height);
+    };
+
+    /**
+     * @class InputQueue
+     *
+     * Collects the input events received between two frames so that they can be dispatched
+     * once per frame instead of as soon as the OS delivers them. Consecutive mouse moves are
+     * merged, keeping only the latest position, and consecutive scrolls are merged by summing
+     * their deltas. Buttons, keys and characters are never merged and keep their ordering.
+     */
+    class InputQueue {
+    public:
+        /**
+         * Queue an event, merging it with the last queued event when possible
+         * @param event Event to queue
+         */
+        void push(InputEvent event);
+
+        /**
+         * Dispatch all the queued events in order, then empty the queue.
+         * Events pushed while dispatching are kept for the next drain.
+         * @param dispatch Callback receiving each event
+         */
+        void drain(const std::function<void(const InputEvent &)> &dispatch);
+
+        /**
+         * Drop all the queued events
+         */
+        void clear();
+
+        bool empty() const;
+        std::size_t size() const;
+
+    protected:
+        std::vector<InputEvent> _events{};
+        std::vector<InputEvent> _dispatching{};
+
+        static bool sameModifiers(const Mod &a, const Mod &b);
+    };
+}
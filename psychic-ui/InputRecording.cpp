@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <stdexcept>
+#include "InputRecording.hpp"
+#include "utils/BinaryData.hpp"
+
+namespace psychic_ui {
+
+    const uint32_t InputRecording::version = 1;
+
+    namespace {
+
+        /**
+         * Layout:
+         *   header (see BinaryWriter::writeHeader), event count
+         *   events:
+         *     time since the previous event (microseconds), type
+         *     mouse move: x, y, buttons, modifiers
+         *     mouse button: x, y, button, down, modifiers
+         *     mouse scroll: x, y, scroll x, scroll y
+         *     keys: key, modifiers
+         *     character: length, UTF-16 code units
+         *     resize: width, height
+         */
+        const char magic[4]{'P', 'U', 'I', 'R'};
+
+        void writeModifiers(BinaryWriter &writer, const Mod &modifiers) {
+            writer.write(static_cast<uint8_t>(
+                             (modifiers.shift ? 1 : 0)
+                             | (modifiers.ctrl ? 2 : 0)
+                             | (modifiers.alt ? 4 : 0)
+                             | (modifiers.super ? 8 : 0)
+                         ));
+        }
+
+        Mod readModifiers(BinaryReader &reader) {
+            auto bits = reader.read<uint8_t>();
+            Mod  modifiers{};
+            modifiers.shift = (bits & 1) != 0;
+            modifiers.ctrl  = (bits & 2) != 0;
+            modifiers.alt   = (bits & 4) != 0;
+            modifiers.super = (bits & 8) != 0;
+            return modifiers;
+        }
+
+    }
+
+    InputRecording::InputRecording() :
+        _start(std::chrono::steady_clock::now()) {}
+
+    void InputRecording::restart() {
+        _entries.clear();
+        _start = std::chrono::steady_clock::now();
+    }
+
+    void InputRecording::add(const InputEvent &event) {
+        add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start), event);
+    }
+
+    void InputRecording::add(const std::chrono::microseconds time, const InputEvent &event) {
+        _entries.push_back({time, event});
+    }
+
+    std::chrono::microseconds InputRecording::duration() const {
+        return _entries.empty() ? std::chrono::microseconds{0} : _entries.back().time;
+    }
+
+    std::vector<uint8_t> InputRecording::serialize() const {
+        BinaryWriter writer{};
+        writer.data.reserve(16 + _entries.size() * 16);
+        writer.writeHeader(magic, version);
+        writer.write(static_cast<uint32_t>(_entries.size()));
+
+        std::chrono::microseconds previous{0};
+        for (const auto &entry: _entries) {
+            // Deltas fit in 32 bits unless nothing happens for more than an hour
+            auto delta = std::max<int64_t>(0, (entry.time - previous).count());
+            writer.write(static_cast<uint32_t>(std::min<int64_t>(delta, UINT32_MAX)));
+            previous = entry.time;
+
+            const InputEvent &event = entry.event;
+            writer.write(static_cast<uint8_t>(event.type));
+            switch (event.type) {
+                case InputEventType::MouseMove:
+                    writer.write(static_cast<int32_t>(event.mouseX));
+                    writer.write(static_cast<int32_t>(event.mouseY));
+                    writer.write(static_cast<int32_t>(event.buttons));
+                    writeModifiers(writer, event.modifiers);
+                    break;
+                case InputEventType::MouseButton:
+                    writer.write(static_cast<int32_t>(event.mouseX));
+                    writer.write(static_cast<int32_t>(event.mouseY));
+                    writer.write(static_cast<uint8_t>(event.button));
+                    writer.write(static_cast<uint8_t>(event.down ? 1 : 0));
+                    writeModifiers(writer, event.modifiers);
+                    break;
+                case InputEventType::MouseScroll:
+                    writer.write(static_cast<int32_t>(event.mouseX));
+                    writer.write(static_cast<int32_t>(event.mouseY));
+                    writer.write(event.scrollX);
+                    writer.write(event.scrollY);
+                    break;
+                case InputEventType::KeyDown:
+                case InputEventType::KeyRepeat:
+                case InputEventType::KeyUp:
+                    writer.write(static_cast<int32_t>(event.key));
+                    writeModifiers(writer, event.modifiers);
+                    break;
+                case InputEventType::Character:
+                    writer.write(static_cast<uint16_t>(event.character.length()));
+                    for (int32_t i = 0; i < event.character.length(); ++i) {
+                        writer.write(static_cast<uint16_t>(event.character.charAt(i)));
+                    }
+                    break;
+                case InputEventType::Resize:
+                    writer.write(static_cast<int32_t>(event.width));
+                    writer.write(static_cast<int32_t>(event.height));
+                    break;
+            }
+        }
+
+        return std::move(writer.data);
+    }
+
+    InputRecording InputRecording::deserialize(const uint8_t *data, const std::size_t size) {
+        BinaryReader reader{data, size, "input recording"};
+        reader.readHeader(magic, version);
+        auto count = reader.read<uint32_t>();
+
+        InputRecording recording{};
+        // Don't trust the count for the allocation, every event takes at least 5 bytes
+        recording._entries.reserve(std::min<std::size_t>(count, size / 5));
+
+        std::chrono::microseconds time{0};
+        for (uint32_t i = 0; i < count; ++i) {
+            time += std::chrono::microseconds(reader.read<uint32_t>());
+
+            InputEvent event{};
+            auto       type = reader.read<uint8_t>();
+            if (type > static_cast<uint8_t>(InputEventType::Resize)) {
+                throw std::runtime_error("Input recording has an unknown event type");
+            }
+            event.type = static_cast<InputEventType>(type);
+            switch (event.type) {
+                case InputEventType::MouseMove:
+                    event.mouseX    = reader.read<int32_t>();
+                    event.mouseY    = reader.read<int32_t>();
+                    event.buttons   = reader.read<int32_t>();
+                    event.modifiers = readModifiers(reader);
+                    break;
+                case InputEventType::MouseButton:
+                    event.mouseX    = reader.read<int32_t>();
+                    event.mouseY    = reader.read<int32_t>();
+                    event.button    = static_cast<MouseButton>(reader.read<uint8_t>());
+                    event.down      = reader.read<uint8_t>() != 0;
+                    event.modifiers = readModifiers(reader);
+                    break;
+                case InputEventType::MouseScroll:
+                    event.mouseX  = reader.read<int32_t>();
+                    event.mouseY  = reader.read<int32_t>();
+                    event.scrollX = reader.read<double>();
+                    event.scrollY = reader.read<double>();
+                    break;
+                case InputEventType::KeyDown:
+                case InputEventType::KeyRepeat:
+                case InputEventType::KeyUp:
+                    event.key       = static_cast<Key>(reader.read<int32_t>());
+                    event.modifiers = readModifiers(reader);
+                    break;
+                case InputEventType::Character: {
+                    auto length = reader.read<uint16_t>();
+                    for (uint16_t c = 0; c < length; ++c) {
+                        event.character.append(static_cast<UChar>(reader.read<uint16_t>()));
+                    }
+                    break;
+                }
+                case InputEventType::Resize:
+                    event.width  = reader.read<int32_t>();
+                    event.height = reader.read<int32_t>();
+                    break;
+            }
+
+            recording._entries.push_back({time, std::move(event)});
+        }
+
+        return recording;
+    }
+
+    void InputRecording::save(const std::string &path) const {
+        BinaryWriter writer{};
+        writer.data = serialize();
+        writer.save(path, "input recording");
+    }
+
+    InputRecording InputRecording::load(const std::string &path) {
+        auto data = BinaryReader::load(path, "input recording");
+        return deserialize(data.data(), data.size());
+    }
+
+}
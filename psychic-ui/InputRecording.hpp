@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "InputQueue.hpp"
+
+namespace psychic_ui {
+
+    /**
+     * @class InputRecording
+     *
+     * Input events received by a system window along with the time they were received at.
+     * Events are recorded as the backend delivers them, before the input queue merges them,
+     * so a replay goes through the same handlers as the original session. Attach a recording
+     * with `SystemWindow::setInputRecording()`, save it, and feed it back with an InputReplayer.
+     *
+     * The binary format stores each event with only the fields its type uses, and times as
+     * deltas from the previous event, after the header written by BinaryWriter.
+     */
+    class InputRecording {
+    public:
+        static const uint32_t version;
+
+        struct Entry {
+            /**
+             * Time since the start of the recording
+             */
+            std::chrono::microseconds time{0};
+            InputEvent                event{};
+        };
+
+        InputRecording();
+
+        /**
+         * Drop the recorded events and restart the clock
+         */
+        void restart();
+
+        /**
+         * Record an event received now
+         */
+        void add(const InputEvent &event);
+
+        /**
+         * Record an event received at a given time since the start of the recording
+         * Times are expected to be increasing.
+         */
+        void add(std::chrono::microseconds time, const InputEvent &event);
+
+        const std::vector<Entry> &entries() const {
+            return _entries;
+        }
+
+        bool empty() const {
+            return _entries.empty();
+        }
+
+        std::size_t size() const {
+            return _entries.size();
+        }
+
+        /**
+         * Duration between the start of the recording and the last event
+         */
+        std::chrono::microseconds duration() const;
+
+        std::vector<uint8_t> serialize() const;
+
+        /**
+         * Read a serialized recording
+         * Throws a `std::runtime_error` if the data is not a valid recording.
+         */
+        static InputRecording deserialize(const uint8_t *data, std::size_t size);
+
+        void save(const std::string &path) const;
+        static InputRecording load(const std::string &path);
+
+    protected:
+        std::chrono::steady_clock::time_point _start;
+        std::vector<Entry>                    _entries{};
+    };
+
+}
@@ -0,0 +1,52 @@
+#include "InputReplayer.hpp"
+#include "ApplicationBase.hpp"
+
+namespace psychic_ui {
+
+    InputReplayer::InputReplayer(SystemWindow *systemWindow, InputRecording recording) :
+        _systemWindow(systemWindow),
+        _recording(std::move(recording)) {
+        _timings.reserve(_recording.size());
+    }
+
+    bool InputReplayer::advance(const std::chrono::microseconds time) {
+        const auto &entries = _recording.entries();
+        while (_next < entries.size() && entries[_next].time <= time) {
+            const auto &entry = entries[_next++];
+            auto       start  = std::chrono::steady_clock::now();
+            if (_systemWindow->replayInput(entry.event)) {
+                _timings.push_back(
+                    {
+                        entry.time,
+                        entry.event.type,
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                    }
+                );
+            }
+        }
+
+        // Like the backends do before drawing, the queued events are dispatched once per frame
+        _systemWindow->dispatchInput(
+            [this, time](const InputEvent &event, const std::chrono::nanoseconds duration) {
+                _timings.push_back({time, event.type, duration});
+            }
+        );
+
+        return !done();
+    }
+
+    void InputReplayer::run(const std::chrono::microseconds frameInterval, const std::function<void()> &frame) {
+        std::chrono::microseconds time{0};
+        while (advance(time)) {
+            if (frame) {
+                frame();
+            }
+            time += frameInterval.count() > 0 ? frameInterval : std::chrono::microseconds{1};
+        }
+        // The last events get their frame too
+        if (frame) {
+            frame();
+        }
+    }
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "InputRecording.hpp"
+
+namespace psychic_ui {
+    class SystemWindow;
+
+    /**
+     * @class InputReplayer
+     *
+     * Feeds an input recording back into a system window, usually a headless one.
+     * The replay runs on a virtual clock advanced by the caller, so it doesn't depend
+     * on how fast the machine is: the same recording always dispatches the same events
+     * between the same frames. Events go through the window's input queue, so moves and
+     * scrolls are merged like they were live, and every dispatched event is timed, which
+     * gives the time spent in the window's handlers for each interaction.
+     *
+     *     auto replayer = InputReplayer(systemWindow, InputRecording::load("bug.pir"));
+     *     replayer.run(std::chrono::milliseconds(16), [&app]() { app.step(); });
+     */
+    class InputReplayer {
+    public:
+        struct DispatchTiming {
+            /**
+             * Time of the event in the recording, or of the frame it was dispatched in when queued
+             */
+            std::chrono::microseconds time{0};
+            InputEventType            type{InputEventType::MouseMove};
+            /**
+             * Time spent dispatching the event
+             */
+            std::chrono::nanoseconds  duration{0};
+        };
+
+        InputReplayer(SystemWindow *systemWindow, InputRecording recording);
+
+        /**
+         * Queue and dispatch the events recorded up to `time` after the start of the recording
+         * @return Whether events are left
+         */
+        bool advance(std::chrono::microseconds time);
+
+        /**
+         * Replay the whole recording, calling `frame` after every `frameInterval` of recording time
+         * @param frameInterval Virtual time between two frames
+         * @param frame Renders a frame, e.g. `HeadlessApplication::step()`
+         */
+        void run(std::chrono::microseconds frameInterval, const std::function<void()> &frame);
+
+        bool done() const {
+            return _next >= _recording.size();
+        }
+
+        const std::vector<DispatchTiming> &timings() const {
+            return _timings;
+        }
+
+    protected:
+        SystemWindow                *_systemWindow;
+        InputRecording              _recording;
+        std::size_t                 _next{0};
+        std::vector<DispatchTiming> _timings{};
+    };
+
+}
@@ -0,0 +1,117 @@
+#include "RenderThread.hpp"
+
+namespace psychic_ui {
+
+    RenderThread::RenderThread(std::function<void()> start, std::function<void(const Frame &)> present, std::function<void()> stop) :
+        _start(std::move(start)),
+        _present(std::move(present)),
+        _stop(std::move(stop)) {
+        // Only start once every member is initialized
+        _thread = std::thread(&RenderThread::run, this);
+    }
+
+    RenderThread::~RenderThread() {
+        stop();
+    }
+
+    void RenderThread::submit(Frame frame) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_hasPending) {
+                ++_dropped;
+            }
+            _pending    = std::move(frame);
+            _hasPending = true;
+        }
+        _frameAvailable.notify_one();
+    }
+
+    void RenderThread::wait() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this]() { return (!_hasPending && !_rendering) || !_running; });
+    }
+
+    void RenderThread::sync(const std::function<void()> &task) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_running) {
+            return;
+        }
+        // Only one caller at a time, the task lives on the caller's stack until it has run,
+        // the thread always runs a set task before it exits
+        _idle.wait(lock, [this]() { return _task == nullptr; });
+        if (!_running) {
+            return;
+        }
+        _task = &task;
+        _frameAvailable.notify_one();
+        _idle.wait(lock, [this, &task]() { return _task != &task; });
+    }
+
+    void RenderThread::stop() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _running = false;
+        }
+        _frameAvailable.notify_one();
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+    }
+
+    uint64_t RenderThread::presented() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _presented;
+    }
+
+    uint64_t RenderThread::dropped() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _dropped;
+    }
+
+    void RenderThread::run() {
+        if (_start) {
+            _start();
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _frameAvailable.wait(lock, [this]() { return _hasPending || _task || !_running; });
+
+            if (_task) {
+                lock.unlock();
+                (*_task)();
+                lock.lock();
+                _task = nullptr;
+                _idle.notify_all();
+                continue;
+            }
+
+            if (!_hasPending) {
+                // Stopped with nothing left to present
+                break;
+            }
+
+            Frame frame = std::move(_pending);
+            _pending    = Frame{};
+            _hasPending = false;
+            _rendering  = true;
+
+            lock.unlock();
+            _present(frame);
+            // Release the picture outside of the lock, it can hold on to a lot
+            frame = Frame{};
+            lock.lock();
+
+            _rendering = false;
+            ++_presented;
+            _idle.notify_all();
+        }
+        _idle.notify_all();
+        lock.unlock();
+
+        if (_stop) {
+            _stop();
+        }
+    }
+
+}
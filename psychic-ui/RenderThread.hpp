@@ -0,0 +1,91 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <SkPicture.h>
+
+namespace psychic_ui {
+
+    /**
+     * @class RenderThread
+     *
+     * Rasterizes and presents recorded frames on its own thread.
+     * The UI thread records each frame into an immutable SkPicture and submits it,
+     * then goes on with the next frame while this thread draws and presents the
+     * previous one. There is one frame being rasterized and at most one waiting:
+     * submitting while a frame is still waiting replaces it, so a slow present
+     * drops frames instead of blocking input handling.
+     */
+    class RenderThread {
+    public:
+        struct Frame {
+            sk_sp<SkPicture> picture{nullptr};
+            int              width{0};
+            int              height{0};
+        };
+
+        /**
+         * @param start Called on the render thread before the first frame, to make the graphics context current
+         * @param present Called on the render thread for every frame, rasterizes and presents it
+         * @param stop Called on the render thread when stopping, to release the graphics context
+         */
+        RenderThread(std::function<void()> start, std::function<void(const Frame &)> present, std::function<void()> stop);
+        ~RenderThread();
+
+        RenderThread(const RenderThread &) = delete;
+        RenderThread &operator=(const RenderThread &) = delete;
+
+        /**
+         * Hand a frame to the render thread, never blocks
+         * @param frame Recorded frame
+         */
+        void submit(Frame frame);
+
+        /**
+         * Block until the submitted frames are presented
+         * Needed before touching what the render thread draws into, like reading back the surface.
+         */
+        void wait();
+
+        /**
+         * Run a task on the render thread between two frames and wait for it
+         * For work that needs the graphics context, like reading back a GPU surface.
+         */
+        void sync(const std::function<void()> &task);
+
+        /**
+         * Stop the thread once the waiting frame is presented
+         */
+        void stop();
+
+        uint64_t presented() const;
+
+        /**
+         * Frames replaced by a newer one before the render thread got to them
+         */
+        uint64_t dropped() const;
+
+    protected:
+        std::function<void()>              _start;
+        std::function<void(const Frame &)> _present;
+        std::function<void()>              _stop;
+
+        mutable std::mutex          _mutex{};
+        std::condition_variable     _frameAvailable{};
+        std::condition_variable     _idle{};
+        const std::function<void()> *_task{nullptr};
+        Frame                       _pending{};
+        bool                        _hasPending{false};
+        bool                        _rendering{false};
+        bool                        _running{true};
+        uint64_t                    _presented{0};
+        uint64_t                    _dropped{0};
+        std::thread                 _thread{};
+
+        void run();
+    };
+
+}
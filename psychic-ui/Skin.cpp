@@ -25,7 +25,7 @@ namespace psychic_ui {
                 orientation
             },
             {
-                opacity,
+                // Not opacity, the component already composites its skin
                 fontSize,  letterSpacing, lineHeight,
                 padding,
                 paddingHorizontal, paddingLeft, paddingRight,
@@ -58,5 +58,28 @@ namespace psychic_ui {
         const InheritableValues SkinBase::inheritableValues() const {
             return _inheritableValues;
         }
+
+        void SkinBase::reset() {
+            resetState();
+        }
+    }
+
+    std::shared_ptr<internal::SkinBase> SkinPool::acquire() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_skins.empty()) {
+            return nullptr;
+        }
+        auto skin = std::move(_skins.back());
+        _skins.pop_back();
+        return skin;
+    }
+
+    void SkinPool::release(std::shared_ptr<internal::SkinBase> skin) {
+        // Only take back skins nobody else holds on to
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (skin && !skin->parent() && skin.use_count() == 1 && _skins.size() < _capacity) {
+            skin->reset();
+            _skins.push_back(std::move(skin));
+        }
     }
 }
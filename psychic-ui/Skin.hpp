@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mutex>
+#include <vector>
 #include "Div.hpp"
 
 namespace psychic_ui {
@@ -9,12 +11,29 @@ namespace psychic_ui {
         public:
             virtual void addedToComponent() {};
             virtual void removedFromComponent() {};
+            /**
+             * Forget what the skin got from its last component, called before it is pooled
+             */
+            virtual void reset();
         protected:
             SkinBase();
             const InheritableValues inheritableValues() const override;
         private:
             static const InheritableValues _inheritableValues;
         };
+
+        class SkinRendererBase {
+        public:
+            virtual ~SkinRendererBase() = default;
+            /**
+             * Whether the renderer can draw this component, checked once when it is picked
+             */
+            virtual bool accepts(const Div *component) const = 0;
+            /**
+             * Draw a component previously accepted by `accepts()`
+             */
+            virtual void draw(Div *component, SkCanvas *canvas) = 0;
+        };
     }
 
     template<class T>
@@ -26,5 +45,54 @@ namespace psychic_ui {
         }
     };
 
+    /**
+     * @class SkinRenderer
+     *
+     * Flyweight skin, a single stateless instance draws for every component using it,
+     * directly into the component, without a Div subtree of its own. Meant for skins
+     * that only draw chrome from their component's size, style and state.
+     * Register it with `StyleManager::registerSkinRenderer`.
+     */
+    template<class T>
+    class SkinRenderer : public internal::SkinRendererBase {
+    public:
+        bool accepts(const Div *component) const override {
+            return dynamic_cast<const T *>(component) != nullptr;
+        }
+
+        void draw(Div *component, SkCanvas *canvas) override {
+            drawComponent(static_cast<T *>(component), canvas);
+        }
+
+    protected:
+        virtual void drawComponent(T *component, SkCanvas *canvas) = 0;
+    };
+
+    /**
+     * @class SkinPool
+     *
+     * Skins released by their components, kept to be handed to the next component
+     * asking for a skin with the same name instead of building a new subtree.
+     * Released skins are `reset()` and components push their state back into the skin
+     * in `skinChanged()`, so only skins holding no other state should be pooled.
+     */
+    class SkinPool {
+    public:
+        explicit SkinPool(std::size_t capacity) : _capacity(capacity) {}
+
+        std::shared_ptr<internal::SkinBase> acquire();
+        void release(std::shared_ptr<internal::SkinBase> skin);
+
+        std::size_t size() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _skins.size();
+        }
+
+    protected:
+        std::size_t                                      _capacity;
+        std::vector<std::shared_ptr<internal::SkinBase>> _skins{};
+        mutable std::mutex                               _mutex{};
+    };
+
 }
 
@@ -0,0 +1,89 @@
+#include "TaskQueue.hpp"
+
+namespace psychic_ui {
+
+    // Intrusive MPSC queue, after Dmitry Vyukov's design:
+    // producers only exchange the head then link the previous node,
+    // the consumer walks from the tail and uses a stub node to never run dry.
+
+    TaskQueue::TaskQueue() :
+        _head(&_stub),
+        _tail(&_stub) {}
+
+    TaskQueue::~TaskQueue() {
+        while (Node *node = pop()) {
+            delete node;
+        }
+    }
+
+    void TaskQueue::post(Task task) {
+        auto node = new Node();
+        node->task = std::move(task);
+        push(node);
+    }
+
+    size_t TaskQueue::drain(const std::chrono::microseconds budget) {
+        auto   start = std::chrono::steady_clock::now();
+        size_t count = 0;
+        while (Node *node = pop()) {
+            Task task = std::move(node->task);
+            delete node;
+            task();
+            ++count;
+            if (std::chrono::steady_clock::now() - start >= budget) {
+                break;
+            }
+        }
+        return count;
+    }
+
+    bool TaskQueue::empty() const {
+        Node *tail = _tail;
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (tail == &_stub) {
+            return next == nullptr && _head.load(std::memory_order_acquire) == &_stub;
+        }
+        return false;
+    }
+
+    void TaskQueue::push(Node *node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node *previous = _head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    TaskQueue::Node *TaskQueue::pop() {
+        Node *tail = _tail;
+        Node *next = tail->next.load(std::memory_order_acquire);
+
+        if (tail == &_stub) {
+            if (!next) {
+                return nullptr;
+            }
+            // Skip over the stub
+            _tail = next;
+            tail  = next;
+            next  = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next) {
+            _tail = next;
+            return tail;
+        }
+
+        if (tail != _head.load(std::memory_order_acquire)) {
+            // A producer swapped the head but didn't link it yet, try again next time
+            return nullptr;
+        }
+
+        // Last node, put the stub back behind it so that it can be released
+        push(&_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            _tail = next;
+            return tail;
+        }
+
+        return nullptr;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+namespace psychic_ui {
+
+    /**
+     * @class TaskQueue
+     *
+     * Lock-free multiple producers / single consumer queue of closures.
+     * Any thread can post tasks, only the main loop thread drains them.
+     * Posting never blocks and never allocates more than the task node.
+     */
+    class TaskQueue {
+    public:
+        using Task = std::function<void()>;
+
+        TaskQueue();
+        ~TaskQueue();
+
+        TaskQueue(const TaskQueue &) = delete;
+        TaskQueue &operator=(const TaskQueue &) = delete;
+
+        /**
+         * Queue a task, safe to call from any thread
+         * @param task Task to run on the consumer thread
+         */
+        void post(Task task);
+
+        /**
+         * Run the queued tasks in order until the queue is empty or the budget is spent.
+         * At least one task is run per call so that a slow task can't stall the queue.
+         * Consumer thread only.
+         * @param budget Time allowed for running tasks
+         * @return Number of tasks that were run
+         */
+        size_t drain(std::chrono::microseconds budget);
+
+        /**
+         * Whether there is nothing left to run, consumer thread only
+         */
+        bool empty() const;
+
+    protected:
+        struct Node {
+            std::atomic<Node *> next{nullptr};
+            Task                task{};
+        };
+
+        /**
+         * Last pushed node, producers swap themselves in
+         */
+        std::atomic<Node *> _head;
+
+        /**
+         * Next node to consume, only touched by the consumer
+         */
+        Node *_tail;
+        Node _stub{};
+
+        void push(Node *node);
+        Node *pop();
+    };
+}
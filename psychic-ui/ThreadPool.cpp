@@ -0,0 +1,91 @@
+#include "ThreadPool.hpp"
+
+namespace psychic_ui {
+
+    ThreadPool::ThreadPool(const unsigned int threads) {
+        _threads.reserve(threads);
+        for (unsigned int i = 0; i < threads; ++i) {
+            _threads.emplace_back(&ThreadPool::work, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _running = false;
+        }
+        _jobAvailable.notify_all();
+        for (auto &thread: _threads) {
+            thread.join();
+        }
+    }
+
+    unsigned int ThreadPool::size() const {
+        return static_cast<unsigned int>(_threads.size());
+    }
+
+    void ThreadPool::parallelFor(const std::size_t count, const std::function<void(std::size_t)> &task) {
+        if (count == 0) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _task          = &task;
+            _count         = count;
+            _next          = 0;
+            _activeWorkers = _threads.size();
+            _exception     = nullptr;
+            ++_generation;
+        }
+        _jobAvailable.notify_all();
+
+        runItems();
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _jobDone.wait(lock, [this]() { return _activeWorkers == 0; });
+        _task = nullptr;
+        if (_exception) {
+            std::exception_ptr exception = _exception;
+            _exception = nullptr;
+            std::rethrow_exception(exception);
+        }
+    }
+
+    void ThreadPool::work() {
+        uint64_t generation = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _jobAvailable.wait(lock, [this, generation]() { return _generation != generation || !_running; });
+                if (!_running) {
+                    return;
+                }
+                generation = _generation;
+            }
+
+            runItems();
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                --_activeWorkers;
+            }
+            _jobDone.notify_one();
+        }
+    }
+
+    void ThreadPool::runItems() {
+        // Items are handed out one at a time, they are expected to be coarse (a whole window)
+        for (std::size_t i = _next++; i < _count; i = _next++) {
+            try {
+                (*_task)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_exception) {
+                    _exception = std::current_exception();
+                }
+            }
+        }
+    }
+
+}
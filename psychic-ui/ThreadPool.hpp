@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace psychic_ui {
+
+    /**
+     * @class ThreadPool
+     *
+     * Fixed set of worker threads running fork-join jobs.
+     * The calling thread takes part in the job and only returns once every
+     * item is done, so a pool of N threads runs jobs on N + 1 threads.
+     * Jobs are not reentrant, only one job runs at a time.
+     */
+    class ThreadPool {
+    public:
+        explicit ThreadPool(unsigned int threads);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        unsigned int size() const;
+
+        /**
+         * Run `task(i)` for every i in [0, count) across the pool and the calling thread
+         * Blocks until every item is done. If items throw, the first exception is
+         * rethrown once the others are done.
+         * @param count Number of items
+         * @param task Task to run for each item
+         */
+        void parallelFor(std::size_t count, const std::function<void(std::size_t)> &task);
+
+    protected:
+        std::vector<std::thread> _threads{};
+
+        std::mutex              _mutex{};
+        std::condition_variable _jobAvailable{};
+        std::condition_variable _jobDone{};
+        bool                    _running{true};
+        uint64_t                _generation{0};
+
+        const std::function<void(std::size_t)> *_task{nullptr};
+        std::size_t                            _count{0};
+        std::atomic<std::size_t>               _next{0};
+        std::size_t                            _activeWorkers{0};
+        std::exception_ptr                     _exception{nullptr};
+
+        void work();
+        void runItems();
+    };
+
+}
@@ -1,9 +1,15 @@
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include "GrBackendSurface.h"
 #include "Window.hpp"
+#include "signals/CoalescingSignal.hpp"
 #include "SkSurface.h"
+#include "SkPictureRecorder.h"
 #include "gl/GrGLInterface.h"
 #include "gl/GrGLUtil.h"
+#include "utils/Profiler.hpp"
+#include "utils/Log.hpp"
 
 
 namespace psychic_ui {
@@ -49,8 +55,8 @@ namespace psychic_ui {
     }
 
     Window::~Window() {
+        stopRenderThread();
         delete _sk_surface;
-        delete _sk_context;
     }
 
     // region Hierarchy
@@ -68,6 +74,9 @@ namespace psychic_ui {
 
         // Setup Skia
         initSkia();
+        if (_threadedRendering) {
+            startRenderThread();
+        }
 
         // Performance
         lastReport = std::chrono::high_resolution_clock::now();
@@ -79,39 +88,92 @@ namespace psychic_ui {
     }
 
     void Window::initSkia() {
-        auto interface = GrGLMakeNativeInterface();
-        _sk_context = GrContext::MakeGL(interface).release();
-        getSkiaSurface();
+        if (_systemWindow->hardwareAccelerated()) {
+            // Either our own or the application's shared context
+            _sk_context = _systemWindow->application()->grContext();
+        }
+        getSkiaSurface(_systemWindow->getWidth(), _systemWindow->getHeight());
     }
 
-    void Window::getSkiaSurface() {
+    void Window::startRenderThread() {
+        if (_sk_context && _systemWindow->application()->sharedContext()) {
+            // A Skia context can only be used by a single thread
+            PSYCHIC_LOG_WARNING("Threaded rendering is not available in shared context mode, rendering on the main thread");
+            return;
+        }
+
+        // Hand the context over, only the render thread touches the surface from now on
+        _systemWindow->detachContext();
+        _renderThread = std::make_unique<RenderThread>(
+            [this]() {
+                _systemWindow->makeContextCurrent();
+                // Each render thread waits for the display on its own, they don't hold each other up
+                bool vsync = _systemWindow->application()->frameScheduler().pacing() == FrameScheduler::Pacing::VSync;
+                _systemWindow->setSwapInterval(vsync ? 1 : 0);
+            },
+            [this](const RenderThread::Frame &frame) { presentFrame(frame); },
+            [this]() {
+                // The surface and the Skia context were used on this thread, they go away with its GL context
+                delete _sk_surface;
+                _sk_surface = nullptr;
+                _sk_canvas  = nullptr;
+                if (_sk_context) {
+                    _sk_context->flush();
+                    _sk_context.reset();
+                }
+                _systemWindow->releaseContext();
+            }
+        );
+    }
+
+    void Window::stopRenderThread() {
+        if (_renderThread) {
+            _renderThread->stop();
+            _renderThread.reset();
+        }
+    }
+
+    void Window::getSkiaSurface(const int width, const int height) {
         if (!_systemWindow) {
             throw std::runtime_error("Skia surface requested without a context");
         }
 
         delete _sk_surface;
 
+        // setup SkSurface
+        // To use distance field text, use commented out SkSurfaceProps instead
+        // SkSurfaceProps props(SkSurfaceProps::kUseDeviceIndependentFonts_Flag,
+        //                      SkSurfaceProps::kLegacyFontHost_InitType);
+        SkSurfaceProps props(SkSurfaceProps::kLegacyFontHost_InitType);
+
+        if (!_sk_context) {
+            // No GPU, render in memory
+            _sk_surface = SkSurface::MakeRaster(
+                SkImageInfo::MakeN32Premul(width, height),
+                &props
+            ).release();
+            if (!_sk_surface) {
+                throw std::runtime_error("Could not create a raster surface");
+            }
+            _sk_canvas = _sk_surface->getCanvas();
+            return;
+        }
+
         GrGLFramebufferInfo framebufferInfo{};
         framebufferInfo.fFBOID = 0;  // assume default framebuffer
         framebufferInfo.fFormat = GR_GL_RGBA8;
 
 
         GrBackendRenderTarget backendRenderTarget(
-            _systemWindow->getWidth(),
-            _systemWindow->getHeight(),
+            width,
+            height,
             _systemWindow->getSamples(),
             _systemWindow->getStencilBits(),
             framebufferInfo
         );
 
-        // setup SkSurface
-        // To use distance field text, use commented out SkSurfaceProps instead
-        // SkSurfaceProps props(SkSurfaceProps::kUseDeviceIndependentFonts_Flag,
-        //                      SkSurfaceProps::kLegacyFontHost_InitType);
-        SkSurfaceProps props(SkSurfaceProps::kLegacyFontHost_InitType);
-
         _sk_surface = SkSurface::MakeFromBackendRenderTarget(
-            _sk_context,
+            _sk_context.get(),
             backendRenderTarget,
             kBottomLeft_GrSurfaceOrigin,
             kRGBA_8888_SkColorType,
@@ -119,7 +181,7 @@ namespace psychic_ui {
             &props
         ).release();
         if (!_sk_surface) {
-            SkDebugf("SkSurface::MakeFromBackendRenderTarget returned null\n");
+            PSYCHIC_LOG_ERROR("SkSurface::MakeFromBackendRenderTarget returned null");
             return;
         }
         _sk_canvas = _sk_surface->getCanvas();
@@ -289,22 +351,82 @@ namespace psychic_ui {
         //}
         //#endif
 
-        // Check for dirty style manager
-        // Before layout since it can have an impact on the layout
-        if (!_styleManager->valid()) {
-            updateStyleRecursive();
-            _styleManager->setValid();
+        // Deliver the signals coalesced since the last frame, their slots can change styles and layout
+        {
+            PSYCHIC_PROFILE_SCOPE("signals");
+            CoalescingSignalBase::flushAll();
         }
 
+        updateFrame();
+        // What the style and layout updates invalidated is drawn by this frame
+        _frameRequested = false;
+
+        //glViewport(0, 0, _fbWidth, _fbHeight);
+        //glBindSampler(0, 0);
+
+        renderFrame();
+        countFrame();
+    }
+
+    sk_sp<SkPicture> Window::recordFrame() {
+        if (!_visible) {
+            return nullptr;
+        }
+        updateFrame();
+        _frameRequested = false;
+        auto picture = recordPicture();
+        countFrame();
+        return picture;
+    }
+
+    void Window::requestFrame() {
+        _frameRequested = true;
+    }
+
+    bool Window::needsFrame() {
+        if (_frameRequested || _resizePending || _styleDirty || YGNodeIsDirty(_yogaNode)) {
+            return true;
+        }
+        return !_styleManager->valid() || _styleSheetRevision != _styleManager->styleSheetRevision();
+    }
+
+    void Window::drawRecordedFrame(sk_sp<SkPicture> picture) {
+        if (!picture) {
+            return;
+        }
+        if (_renderThread) {
+            auto bounds = picture->cullRect();
+            _renderThread->submit({std::move(picture), static_cast<int>(bounds.width()), static_cast<int>(bounds.height())});
+            return;
+        }
+        fitSkiaSurface();
+        {
+            PSYCHIC_PROFILE_SCOPE("render");
+            _sk_canvas->clear(0x00000000);
+            _sk_canvas->drawPicture(picture);
+        }
+        PSYCHIC_PROFILE_SCOPE("flush");
+        _sk_canvas->flush();
+    }
+
+    void Window::updateFrame() {
+        applyResize();
+
+        // Before layout since it can have an impact on the layout
+        updateStyles();
+
         // Do Layout
         if (YGNodeIsDirty(_yogaNode)) {
             #ifdef DEBUG_LAYOUT
             if (debugLayout) {
-                std::cout << "Layout dirty!" << std::endl;
+                PSYCHIC_LOG_DEBUG("Layout dirty!");
             }
             #endif
-            YGNodeCalculateLayout(_yogaNode, _width, _height, YGDirectionLTR);
-            layoutUpdated();
+            calculateLayout();
+            {
+                PSYCHIC_PROFILE_SCOPE("layoutUpdated");
+                layoutUpdated();
+            }
             #ifdef DEBUG_LAYOUT
             if (debugLayout) {
                 YGNodePrint(
@@ -316,15 +438,36 @@ namespace psychic_ui {
             }
             #endif
         }
+    }
 
-        //glViewport(0, 0, _fbWidth, _fbHeight);
-        //glBindSampler(0, 0);
+    void Window::applyResize() {
+        if (!_resizePending) {
+            return;
+        }
 
-        _sk_canvas->clear(0x00000000);
-        render(_sk_canvas);
-        _sk_canvas->flush();
+        auto now = std::chrono::steady_clock::now();
+        if (now - _lastResizeLayout < _liveResizeInterval) {
+            // Still resizing, keep the previous layout a little longer
+            return;
+        }
 
-        // Performance
+        PSYCHIC_PROFILE_SCOPE("resize");
+        YGNodeStyleSetWidth(_yogaNode, _pendingWidth);
+        YGNodeStyleSetHeight(_yogaNode, _pendingHeight);
+        _resizePending    = false;
+        _lastResizeLayout = now;
+    }
+
+    void Window::fitSkiaSurface() {
+        int width  = _systemWindow->getWidth();
+        int height = _systemWindow->getHeight();
+        if (!_sk_surface || _sk_surface->width() != width || _sk_surface->height() != height) {
+            PSYCHIC_PROFILE_SCOPE("surface");
+            getSkiaSurface(width, height);
+        }
+    }
+
+    void Window::countFrame() {
         ++frames;
         double delta = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::high_resolution_clock::now()
@@ -337,6 +480,146 @@ namespace psychic_ui {
         }
     }
 
+    void Window::updateStyles() {
+        PSYCHIC_PROFILE_SCOPE("style");
+        _styleManager->reloadStyleSheets();
+
+        // Check for dirty style manager
+        if (!_styleManager->valid()) {
+            updateStyleRecursive();
+            _styleManager->setValid();
+        } else if (_styleSheetRevision + 1 == _styleManager->styleSheetRevision()) {
+            // Stylesheets were reloaded, only restyle what their changes affect
+            _styleManager->invalidateChanged(this);
+        } else if (_styleSheetRevision != _styleManager->styleSheetRevision()) {
+            // Missed a reload, we can't know what changed
+            updateStyleRecursive();
+        }
+        _styleSheetRevision = _styleManager->styleSheetRevision();
+    }
+
+    void Window::calculateLayout() {
+        PSYCHIC_PROFILE_SCOPE("layout");
+        std::lock_guard<std::mutex> lock(layoutMutex());
+        YGNodeCalculateLayout(_yogaNode, _width, _height, YGDirectionLTR);
+    }
+
+    void Window::renderFrame() {
+        if (_renderThread) {
+            drawRecordedFrame(recordPicture());
+            return;
+        }
+
+        fitSkiaSurface();
+        {
+            PSYCHIC_PROFILE_SCOPE("render");
+            _sk_canvas->clear(0x00000000);
+            render(_sk_canvas);
+            drawLatencyOverlay(_sk_canvas);
+        }
+        PSYCHIC_PROFILE_SCOPE("flush");
+        _sk_canvas->flush();
+    }
+
+    sk_sp<SkPicture> Window::recordPicture() {
+        PSYCHIC_PROFILE_SCOPE("record");
+        SkPictureRecorder recorder;
+        SkCanvas          *canvas = recorder.beginRecording(
+            SkRect::MakeIWH(_systemWindow->getWidth(), _systemWindow->getHeight())
+        );
+        canvas->clear(0x00000000);
+        render(canvas);
+        drawLatencyOverlay(canvas);
+        return recorder.finishRecordingAsPicture();
+    }
+
+    void Window::drawLatencyOverlay(SkCanvas *canvas) {
+        if (!_latencyOverlay || !_systemWindow) {
+            return;
+        }
+
+        const LatencyHistogram &latency = _systemWindow->inputLatency();
+        auto                   ms       = [](std::chrono::microseconds time) { return time.count() / 1000.0; };
+        char                   text[128];
+        snprintf(
+            text, sizeof(text), "input to present  p50 %.1fms  p95 %.1fms  max %.1fms  (%llu)",
+            ms(latency.percentile(0.5)), ms(latency.percentile(0.95)), ms(latency.max()),
+            static_cast<unsigned long long>(latency.count())
+        );
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setTextSize(11.0f);
+        SkRect bounds;
+        paint.measureText(text, strlen(text), &bounds);
+
+        paint.setColor(0xC0000000);
+        canvas->drawRect(SkRect::MakeXYWH(4.0f, 4.0f, bounds.width() + 12.0f, 20.0f), paint);
+        paint.setColor(0xFFFFFFFF);
+        canvas->drawText(text, strlen(text), 10.0f, 18.0f, paint);
+    }
+
+    void Window::presentFrame(const RenderThread::Frame &frame) {
+        if (!_sk_surface || _sk_surface->width() != frame.width || _sk_surface->height() != frame.height) {
+            getSkiaSurface(frame.width, frame.height);
+        }
+        {
+            PSYCHIC_PROFILE_SCOPE("rasterize");
+            _sk_canvas->clear(0x00000000);
+            _sk_canvas->drawPicture(frame.picture);
+            _sk_canvas->flush();
+        }
+        PSYCHIC_PROFILE_SCOPE("swap");
+        _systemWindow->swapBuffers();
+    }
+
+    sk_sp<SkImage> Window::snapshot() const {
+        if (_renderThread) {
+            // The surface belongs to the render thread, and so does the GL context to read it back
+            sk_sp<SkImage> image{nullptr};
+            _renderThread->sync(
+                [this, &image]() {
+                    if (_sk_surface) {
+                        image = _sk_surface->makeImageSnapshot();
+                        if (_sk_context) {
+                            image = image->makeRasterImage();
+                        }
+                    }
+                }
+            );
+            return image;
+        }
+        return _sk_surface ? _sk_surface->makeImageSnapshot() : nullptr;
+    }
+
+    bool Window::threadedRendering() const {
+        return _threadedRendering;
+    }
+
+    void Window::setThreadedRendering(const bool threadedRendering) {
+        _threadedRendering = threadedRendering;
+    }
+
+    std::chrono::milliseconds Window::liveResizeInterval() const {
+        return _liveResizeInterval;
+    }
+
+    void Window::setLiveResizeInterval(const std::chrono::milliseconds interval) {
+        _liveResizeInterval = interval;
+    }
+
+    bool Window::latencyOverlay() const {
+        return _latencyOverlay;
+    }
+
+    void Window::setLatencyOverlay(const bool latencyOverlay) {
+        _latencyOverlay = latencyOverlay;
+    }
+
+    bool Window::renderThreadActive() const {
+        return _renderThread != nullptr;
+    }
+
     // endregion
 
     // region Modals
@@ -423,6 +706,18 @@ namespace psychic_ui {
 
     // endregion
 
+    // region Input
+
+    bool Window::rawInput() const {
+        return _rawInput;
+    }
+
+    void Window::setRawInput(bool rawInput) {
+        _rawInput = rawInput;
+    }
+
+    // endregion
+
     // region Keyboard Events
 
     void Window::startTextInput() {
@@ -500,12 +795,11 @@ namespace psychic_ui {
     void Window::windowResized(const int width, const int height) {
         // std::cout << "Resized" << std::endl;
 
-        // Set setLayout setSize
-        YGNodeStyleSetWidth(_yogaNode, width);
-        YGNodeStyleSetHeight(_yogaNode, height);
-
-        // Get a new surface
-        getSkiaSurface();
+        // Interactive resizing sends many events per frame, only the last size is used by the next frame.
+        // The surface follows the system window size when drawing, the render thread does it itself.
+        _resizePending = true;
+        _pendingWidth  = width;
+        _pendingHeight = height;
     }
 
     void Window::windowActivated() {
@@ -15,6 +15,7 @@
 #include "components/Menu.hpp"
 #include "signals/Signal.hpp"
 #include "ApplicationBase.hpp"
+#include "RenderThread.hpp"
 
 namespace psychic_ui {
 
@@ -63,6 +64,77 @@ namespace psychic_ui {
         void close();
         void drawAll();
 
+        /**
+         * Ask for a new frame
+         * Windows are only drawn when something changed, divs request a frame when their
+         * rendering is invalidated. Anything drawing from state the window can't see changing
+         * has to call this.
+         */
+        void requestFrame();
+
+        /**
+         * Whether the window changed since its last frame
+         * Doesn't check the watched stylesheets, the main loop reloads them before asking.
+         */
+        bool needsFrame();
+
+        /**
+         * Restyle, lay out and record the window into a picture without drawing it
+         * Windows sharing a style manager can record their frames on different threads
+         * once it is in its frame phase, see `StyleManager::beginFrame()`. Coalesced signals
+         * are not flushed, the caller has to do it before.
+         * @return Recorded frame, nullptr if the window isn't visible
+         */
+        sk_sp<SkPicture> recordFrame();
+
+        /**
+         * Draw a frame from `recordFrame()` into the surface, or hand it to the render thread
+         * The window's graphics context has to be current, buffers are not swapped.
+         */
+        void drawRecordedFrame(sk_sp<SkPicture> picture);
+
+        /**
+         * Image of the last rendered frame
+         * @return Snapshot of the window's surface, nullptr if the window isn't open
+         */
+        sk_sp<SkImage> snapshot() const;
+
+        /**
+         * Rasterize and present the frames on a dedicated render thread
+         * The main thread then only records each frame into an SkPicture and can start
+         * on the next one while the previous one is drawn, flushed and swapped.
+         * Has to be set before the window is opened, not available in shared context mode.
+         */
+        bool threadedRendering() const;
+        void setThreadedRendering(bool threadedRendering);
+
+        /**
+         * Minimum time between two layouts while the window is being resized
+         * Resize events are coalesced into one per frame. While they keep coming, the layout
+         * follows the new size at most once per interval and the surface keeps up every frame.
+         * 0 lays out every frame.
+         */
+        std::chrono::milliseconds liveResizeInterval() const;
+        void setLiveResizeInterval(std::chrono::milliseconds interval);
+
+        /**
+         * Draw the input to present latency of the window over its content
+         */
+        bool latencyOverlay() const;
+        void setLatencyOverlay(bool latencyOverlay);
+
+        /**
+         * Whether the frames are currently presented by a render thread
+         */
+        bool renderThreadActive() const;
+
+        /**
+         * Stop the render thread after it presented the last frame
+         * The surface and Skia context are released on the render thread, the window
+         * can't draw anymore. Called by the backends before their graphics context goes away.
+         */
+        void stopRenderThread();
+
         void openMenu(const std::vector<std::shared_ptr<MenuItem>> &items, int x, int y);
         void closeMenu();
 
@@ -134,6 +206,24 @@ namespace psychic_ui {
 
         // endregion
 
+        // region Input
+
+        /**
+         * Whether input events are dispatched as soon as they are received
+         * instead of being coalesced and dispatched once per frame
+         * @return bool
+         */
+        bool rawInput() const;
+
+        /**
+         * Enable raw input, every mouse move is then dispatched as it is received.
+         * Useful for drawing applications that need every sample, at a performance cost.
+         * @param rawInput
+         */
+        void setRawInput(bool rawInput);
+
+        // endregion
+
         // region Keyboard
 
         void startTextInput();
@@ -159,10 +249,26 @@ namespace psychic_ui {
 
         // region Rendering
 
-        SystemWindow *_systemWindow{nullptr};
-        GrContext    *_sk_context{nullptr};
-        SkSurface    *_sk_surface{nullptr};
-        SkCanvas     *_sk_canvas{nullptr};
+        SystemWindow                  *_systemWindow{nullptr};
+        sk_sp<GrContext>              _sk_context{nullptr};
+        SkSurface                     *_sk_surface{nullptr};
+        SkCanvas                      *_sk_canvas{nullptr};
+        bool                          _threadedRendering{false};
+        std::unique_ptr<RenderThread> _renderThread{nullptr};
+        bool                          _latencyOverlay{false};
+        /**
+         * Something asked for a frame since the last one
+         */
+        bool                          _frameRequested{true};
+
+        // endregion
+
+        // region Style
+
+        /**
+         * Last stylesheet revision of the style manager this window was restyled for
+         */
+        uint64_t _styleSheetRevision{0};
 
         // endregion
 
@@ -177,6 +283,15 @@ namespace psychic_ui {
         //int   _fbHeight{0};
         float _pixelRatio;
 
+        /**
+         * Size of the last resize event, applied to the layout at the start of the next frame
+         */
+        bool                                  _resizePending{false};
+        int                                   _pendingWidth{0};
+        int                                   _pendingHeight{0};
+        std::chrono::milliseconds             _liveResizeInterval{33};
+        std::chrono::steady_clock::time_point _lastResizeLayout{};
+
         // endregion
 
         // region Mouse
@@ -189,12 +304,72 @@ namespace psychic_ui {
         //int _mouseX{0};
         //int _mouseY{0};
 
+        /**
+         * Dispatch input events as soon as they are received
+         */
+        bool _rawInput{false};
+
         // endregion
 
         // region Initialization
 
         void initSkia();
-        void getSkiaSurface();
+        void getSkiaSurface(int width, int height);
+        void startRenderThread();
+
+        // endregion
+
+        // region Frame
+
+        /**
+         * Update the styles and the layout of the window
+         */
+        void updateFrame();
+
+        /**
+         * Lay out for the coalesced window size, unless it was done too recently while resizing
+         */
+        void applyResize();
+
+        /**
+         * Recreate the surface if it doesn't have the size of the window anymore
+         */
+        void fitSkiaSurface();
+
+        /**
+         * Restyle the whole window if the style manager was invalidated
+         */
+        void updateStyles();
+
+        /**
+         * Compute the yoga layout, `layoutUpdated` has to be called afterwards
+         */
+        void calculateLayout();
+
+        /**
+         * Clear the surface and render the window in it
+         */
+        void renderFrame();
+
+        /**
+         * Record the window into a picture the size of the window
+         */
+        sk_sp<SkPicture> recordPicture();
+
+        /**
+         * Update the fps counter
+         */
+        void countFrame();
+
+        /**
+         * Draw the latency percentiles in the top left corner
+         */
+        void drawLatencyOverlay(SkCanvas *canvas);
+
+        /**
+         * Draw a recorded frame into the surface and present it, on the render thread
+         */
+        void presentFrame(const RenderThread::Frame &frame);
 
         // endregion
 
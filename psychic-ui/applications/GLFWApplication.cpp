@@ -2,6 +2,8 @@
 
 #include <unicode/unistr.h>
 #include "GLFWApplication.hpp"
+#include "../utils/Profiler.hpp"
+#include "../utils/Log.hpp"
 
 namespace psychic_ui {
 
@@ -71,7 +73,7 @@ namespace psychic_ui {
                 if (error == GLFW_NOT_INITIALIZED) {
                     return;
                 }
-                std::cerr << "GLFW error " << error << ": " << descr << std::endl;
+                PSYCHIC_LOG_ERROR("GLFW error " << error << ": " << descr);
             }
         );
 
@@ -79,7 +81,7 @@ namespace psychic_ui {
             throw std::runtime_error("Could not initialize GLFW!");
         }
 
-        std::cout << "GLFW Version: " << glfwGetVersionString() << std::endl;
+        PSYCHIC_LOG_INFO("GLFW Version: " << glfwGetVersionString());
 
         glfwSetTime(0);
     }
@@ -92,27 +94,33 @@ namespace psychic_ui {
         running = true;
 
         while (running) {
-            glfwPollEvents();
-
-            int       numScreens = 0;
-            for (auto &kv : glfwWindows) {
-                if (kv.second->render()) {
-                    numScreens++;
-                }
-            }
-
-            // Cleanup dirty managers
-            for (auto &kv : glfwWindows) {
-                kv.second->window()->styleManager()->setValid();
+            // Block while there is nothing to draw, until an event comes or a timer is due
+            auto timeout = idleTimeout(systemWindows());
+            if (timeout.count() == 0) {
+                glfwPollEvents();
+            } else if (timeout == std::chrono::microseconds::max()) {
+                glfwWaitEvents();
+            } else {
+                glfwWaitEventsTimeout(timeout.count() / 1000000.0);
             }
 
-            if (numScreens == 0) {
+            // Events can open and close windows
+            if (frame(systemWindows()) == 0) {
                 running = false;
                 break;
             }
         }
     }
 
+    std::vector<SystemWindow *> GLFWApplication::systemWindows() const {
+        std::vector<SystemWindow *> windows{};
+        windows.reserve(glfwWindows.size());
+        for (auto &kv : glfwWindows) {
+            windows.push_back(kv.second.get());
+        }
+        return windows;
+    }
+
     void GLFWApplication::open(std::shared_ptr<Window> window) {
         auto systemWindow = std::make_unique<GLFWSystemWindow>(this, window);
         glfwWindows[systemWindow->glfwWindow()] = std::move(systemWindow);
@@ -124,12 +132,21 @@ namespace psychic_ui {
         if (res != glfwWindows.cend()) {
             glfwWindows.erase(res->first);
         }
+        if (glfwWindows.empty()) {
+            // The share group went away with the last window
+            releaseSharedContext();
+        }
     }
 
     void GLFWApplication::shutdown() {
+        releaseSharedContext();
         glfwTerminate();
     }
 
+    void GLFWApplication::wakeUp() {
+        glfwPostEmptyEvent();
+    }
+
     // WINDOW
 
     GLFWSystemWindow::GLFWSystemWindow(GLFWApplication *application, std::shared_ptr<Window> window) :
@@ -160,12 +177,18 @@ namespace psychic_ui {
 
         // CREATE WINDOW
 
+        // In shared context mode, join the share group of the windows already opened
+        GLFWwindow *share = nullptr;
+        if (application->sharedContext() && !GLFWApplication::glfwWindows.empty()) {
+            share = GLFWApplication::glfwWindows.cbegin()->first;
+        }
+
         if (window->getFullscreen()) {
             GLFWmonitor       *monitor = glfwGetPrimaryMonitor();
             const GLFWvidmode *mode    = glfwGetVideoMode(monitor);
-            _glfwWindow = glfwCreateWindow(mode->width, mode->height, window->getTitle().c_str(), monitor, nullptr);
+            _glfwWindow = glfwCreateWindow(mode->width, mode->height, window->getTitle().c_str(), monitor, share);
         } else {
-            _glfwWindow = glfwCreateWindow(_width, _height, window->getTitle().c_str(), nullptr, nullptr);
+            _glfwWindow = glfwCreateWindow(_width, _height, window->getTitle().c_str(), nullptr, share);
         }
 
         if (!_glfwWindow) {
@@ -184,7 +207,7 @@ namespace psychic_ui {
 
         // GL CONTEXT
 
-        glfwMakeContextCurrent(_glfwWindow);
+        activateContext();
 
         #if defined(PSYCHIC_UI_GLAD)
         if (!gladInitialized) {
@@ -200,7 +223,6 @@ namespace psychic_ui {
 
         glClearColor(0, 0, 0, 0);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-        glfwSwapInterval(0);
         glfwSwapBuffers(_glfwWindow);
 
         #if defined(__APPLE__)
@@ -233,6 +255,9 @@ namespace psychic_ui {
     }
 
     GLFWSystemWindow::~GLFWSystemWindow() {
+        // The render thread can't be using the context when it goes away
+        _window->stopRenderThread();
+
         for (auto &_cursor : _cursors) {
             if (_cursor) {
                 glfwDestroyCursor(_cursor);
@@ -246,13 +271,20 @@ namespace psychic_ui {
         return _glfwWindow;
     }
 
-    bool GLFWSystemWindow::render() {
+    bool GLFWSystemWindow::ready() {
         if (!_window->getVisible()) {
             return false;
         } else if (glfwWindowShouldClose(_glfwWindow)) {
             _window->setVisible(false);
             return false;
         }
+        return true;
+    }
+
+    bool GLFWSystemWindow::render() {
+        if (!ready()) {
+            return false;
+        }
 
         //glfwMakeContextCurrent(_glfwWindow);
         //glClearColor(0, 0, 0, 0);
@@ -273,13 +305,39 @@ namespace psychic_ui {
         //}
         //#endif
 
+        PSYCHIC_PROFILE_FRAME();
+        {
+            PSYCHIC_PROFILE_SCOPE("input");
+            dispatchInput();
+        }
+        activateContext();
         _window->drawAll();
 
-        glfwSwapBuffers(_glfwWindow);
+        if (!_window->renderThreadActive()) {
+            PSYCHIC_PROFILE_SCOPE("swap");
+            swapFrame();
+        }
+        framePresented();
 
         return true;
     }
 
+    void GLFWSystemWindow::makeContextCurrent() {
+        glfwMakeContextCurrent(_glfwWindow);
+    }
+
+    void GLFWSystemWindow::releaseContext() {
+        glfwMakeContextCurrent(nullptr);
+    }
+
+    void GLFWSystemWindow::swapBuffers() {
+        glfwSwapBuffers(_glfwWindow);
+    }
+
+    void GLFWSystemWindow::setSwapInterval(const int interval) {
+        glfwSwapInterval(interval);
+    }
+
     void GLFWSystemWindow::setSize(int width, int height) {
         _width  = width;
         _height = height;
@@ -497,7 +555,7 @@ namespace psychic_ui {
             glfwSetWindowPos(_glfwWindow, _x + _windowDragOffsetX, _y + _windowDragOffsetY);
         }
 
-        _window->mouseMoved(_mouseX, _mouseY, _mouseState, _modifiers, false);
+        queueInput(InputEvent::mouseMove(_mouseX, _mouseY, _mouseState, _modifiers));
     }
 
     void GLFWSystemWindow::mouseButtonEventCallback(int button, int action, int modifiers) {
@@ -521,7 +579,7 @@ namespace psychic_ui {
             _mouseState &= ~btn;
         }
 
-        _window->mouseButton(_mouseX, _mouseY, btn, action == GLFW_PRESS, _modifiers);
+        queueInput(InputEvent::mouseButton(_mouseX, _mouseY, btn, action == GLFW_PRESS, _modifiers));
         //if (action == GLFW_PRESS) {
         //    _window->mouseDown(_mouseX, _mouseY, btn, _modifiers);
         //} else {
@@ -532,7 +590,7 @@ namespace psychic_ui {
 
     void GLFWSystemWindow::scrollEventCallback(double x, double y) {
         _lastInteraction = glfwGetTime();
-        _window->mouseScrolled(_mouseX, _mouseY, x, y);
+        queueInput(InputEvent::mouseScroll(_mouseX, _mouseY, x, y));
     }
 
     /**
@@ -546,15 +604,15 @@ namespace psychic_ui {
         _lastInteraction = glfwGetTime();
         switch (action) {
             case GLFW_PRESS:
-                _window->keyDown(mapKey(key), mapMods(mods));
+                queueInput(InputEvent::keyDown(mapKey(key), mapMods(mods)));
                 break;
 
             case GLFW_REPEAT:
-                _window->keyRepeat(mapKey(key), mapMods(mods));
+                queueInput(InputEvent::keyRepeat(mapKey(key), mapMods(mods)));
                 break;
 
             case GLFW_RELEASE:
-                _window->keyUp(mapKey(key), mapMods(mods));
+                queueInput(InputEvent::keyUp(mapKey(key), mapMods(mods)));
                 break;
 
             default:break;
@@ -567,7 +625,7 @@ namespace psychic_ui {
      */
     void GLFWSystemWindow::charEventCallback(unsigned int codepoint) {
         _lastInteraction = glfwGetTime();
-        _window->keyboardCharacterEvent(icu::UnicodeString(static_cast<UChar32>(codepoint)));
+        queueInput(InputEvent::characterInput(icu::UnicodeString(static_cast<UChar32>(codepoint))));
     }
 
     void GLFWSystemWindow::dropEventCallback(int count, const char **filenames) {
@@ -594,7 +652,7 @@ namespace psychic_ui {
 
         _lastInteraction = glfwGetTime();
 
-        _window->windowResized(_width, _height);
+        resized();
     }
 
     void GLFWSystemWindow::positionEventCallback(int x, int y) {
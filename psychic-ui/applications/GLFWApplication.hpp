@@ -51,6 +51,10 @@ namespace psychic_ui {
     protected:
         static std::unordered_map<GLFWwindow *, std::unique_ptr<GLFWSystemWindow>> glfwWindows;
 
+        void wakeUp() override;
+
+        std::vector<SystemWindow *> systemWindows() const;
+
         bool running{false};
     };
 
@@ -61,7 +65,12 @@ namespace psychic_ui {
         GLFWSystemWindow(GLFWApplication *application, std::shared_ptr<Window> window);
         ~GLFWSystemWindow();
         GLFWwindow *glfwWindow() const;
+        bool ready() override;
         bool render() override;
+        void makeContextCurrent() override;
+        void releaseContext() override;
+        void swapBuffers() override;
+        void setSwapInterval(int interval) override;
 
     protected:
         GLFWApplication *_glfwApplication{nullptr};
@@ -0,0 +1,229 @@
+#include <fstream>
+#include <unicode/unistr.h>
+#include "HeadlessApplication.hpp"
+#include "../utils/Profiler.hpp"
+
+namespace psychic_ui {
+
+    // APPLICATION
+
+    void HeadlessApplication::init() {
+        // Nothing to initialize, there is no system to talk to
+    }
+
+    void HeadlessApplication::mainloop() {
+        if (running) {
+            throw std::runtime_error("Main loop is already running!");
+        }
+
+        running = true;
+
+        while (running) {
+            if (step() == 0) {
+                running = false;
+                break;
+            }
+        }
+    }
+
+    int HeadlessApplication::step() {
+        // Frames are not paced unless asked to, so that runs are reproducible
+        return frame(systemWindows());
+    }
+
+    void HeadlessApplication::open(std::shared_ptr<Window> window) {
+        headlessWindows[window.get()] = std::make_unique<HeadlessSystemWindow>(this, window);
+    }
+
+    void HeadlessApplication::close(std::shared_ptr<Window> window) {
+        headlessWindows.erase(window.get());
+    }
+
+    void HeadlessApplication::shutdown() {
+        running = false;
+        headlessWindows.clear();
+    }
+
+    std::vector<SystemWindow *> HeadlessApplication::systemWindows() const {
+        std::vector<SystemWindow *> windows{};
+        windows.reserve(headlessWindows.size());
+        for (auto &kv : headlessWindows) {
+            windows.push_back(kv.second.get());
+        }
+        return windows;
+    }
+
+    HeadlessSystemWindow *HeadlessApplication::systemWindow(const std::shared_ptr<Window> &window) const {
+        auto it = headlessWindows.find(window.get());
+        return it != headlessWindows.cend() ? it->second.get() : nullptr;
+    }
+
+    // WINDOW
+
+    HeadlessSystemWindow::HeadlessSystemWindow(HeadlessApplication *application, std::shared_ptr<Window> window) :
+        SystemWindow(application, window), _headlessApplication(application) {
+        _samples     = 0;
+        _stencilBits = 0;
+        _pixelRatio  = 1.0f;
+        _focused     = true;
+        window->open(this);
+    }
+
+    bool HeadlessSystemWindow::render() {
+        if (!_window->getVisible()) {
+            return false;
+        }
+
+        PSYCHIC_PROFILE_FRAME();
+        {
+            PSYCHIC_PROFILE_SCOPE("input");
+            dispatchInput();
+        }
+        _window->drawAll();
+        swapFrame();
+        framePresented();
+
+        return true;
+    }
+
+    bool HeadlessSystemWindow::hardwareAccelerated() const {
+        return false;
+    }
+
+    void HeadlessSystemWindow::swapBuffers() {
+        // Nothing to show, the frame stays in the window's raster surface
+        ++_frameCount;
+    }
+
+    unsigned int HeadlessSystemWindow::frameCount() const {
+        return _frameCount;
+    }
+
+    // region Synthetic Input
+
+    void HeadlessSystemWindow::mouseMove(const int x, const int y) {
+        _mouseX = x;
+        _mouseY = y;
+        queueInput(InputEvent::mouseMove(_mouseX, _mouseY, _mouseState, _modifiers));
+    }
+
+    void HeadlessSystemWindow::mouseDown(const int x, const int y, const MouseButton button) {
+        mouseMove(x, y);
+        _mouseState |= button;
+        queueInput(InputEvent::mouseButton(_mouseX, _mouseY, button, true, _modifiers));
+    }
+
+    void HeadlessSystemWindow::mouseUp(const int x, const int y, const MouseButton button) {
+        mouseMove(x, y);
+        _mouseState &= ~button;
+        queueInput(InputEvent::mouseButton(_mouseX, _mouseY, button, false, _modifiers));
+    }
+
+    void HeadlessSystemWindow::click(const int x, const int y, const MouseButton button) {
+        mouseDown(x, y, button);
+        mouseUp(x, y, button);
+    }
+
+    void HeadlessSystemWindow::mouseScroll(const int x, const int y, const double scrollX, const double scrollY) {
+        mouseMove(x, y);
+        queueInput(InputEvent::mouseScroll(_mouseX, _mouseY, scrollX, scrollY));
+    }
+
+    void HeadlessSystemWindow::keyDown(const Key key, const Mod modifiers) {
+        _modifiers = modifiers;
+        queueInput(InputEvent::keyDown(key, _modifiers));
+    }
+
+    void HeadlessSystemWindow::keyUp(const Key key, const Mod modifiers) {
+        _modifiers = modifiers;
+        queueInput(InputEvent::keyUp(key, _modifiers));
+    }
+
+    void HeadlessSystemWindow::type(const std::string &text) {
+        icu::UnicodeString str = icu::UnicodeString::fromUTF8(text);
+        for (int32_t       i   = 0; i < str.length(); i = str.moveIndex32(i, 1)) {
+            queueInput(InputEvent::characterInput(icu::UnicodeString(str.char32At(i))));
+        }
+    }
+
+    // endregion
+
+    // region Read Back
+
+    sk_sp<SkImage> HeadlessSystemWindow::snapshot() const {
+        return _window->snapshot();
+    }
+
+    bool HeadlessSystemWindow::readPixels(const SkImageInfo &info, void *pixels, size_t rowBytes) const {
+        auto image = snapshot();
+        return image && image->readPixels(info, pixels, rowBytes, 0, 0);
+    }
+
+    sk_sp<SkData> HeadlessSystemWindow::encodePNG() const {
+        auto image = snapshot();
+        return image ? image->encodeToData(SkEncodedImageFormat::kPNG, 100) : nullptr;
+    }
+
+    bool HeadlessSystemWindow::savePNG(const std::string &path) const {
+        auto data = encodePNG();
+        if (!data) {
+            return false;
+        }
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        file.write(static_cast<const char *>(data->data()), data->size());
+        return file.good();
+    }
+
+    // endregion
+
+    // region System Window
+
+    void HeadlessSystemWindow::setTitle(const std::string &/*title*/) {}
+
+    void HeadlessSystemWindow::setFullscreen(bool /*fullscreen*/) {}
+
+    bool HeadlessSystemWindow::getMinimized() const {
+        return _minimized;
+    }
+
+    void HeadlessSystemWindow::setMinimized(const bool minimized) {
+        _minimized = minimized;
+    }
+
+    bool HeadlessSystemWindow::getMaximized() const {
+        return _maximized;
+    }
+
+    void HeadlessSystemWindow::setMaximized(const bool maximized) {
+        _maximized = maximized;
+    }
+
+    void HeadlessSystemWindow::setVisible(bool /*visible*/) {}
+
+    void HeadlessSystemWindow::setCursor(int /*cursor*/) {}
+
+    void HeadlessSystemWindow::startDrag() {}
+
+    void HeadlessSystemWindow::stopDrag() {}
+
+    void HeadlessSystemWindow::setSize(const int width, const int height) {
+        if (_width == width && _height == height) {
+            return;
+        }
+        _width  = width;
+        _height = height;
+        resized();
+    }
+
+    void HeadlessSystemWindow::setPosition(const int x, const int y) {
+        _x = x;
+        _y = y;
+        _window->windowMoved(_x, _y);
+    }
+
+    // endregion
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <SkImage.h>
+#include <SkData.h>
+#include "../Window.hpp"
+#include "psychic-ui/ApplicationBase.hpp"
+
+namespace psychic_ui {
+
+    class HeadlessSystemWindow;
+
+    /**
+     * @class HeadlessApplication
+     *
+     * Application without any system window or GPU, windows are rendered
+     * in CPU raster surfaces. Frames are produced either by the main loop
+     * or one at a time with `step()`, input can be injected through the
+     * system windows. Meant for tests, benchmarks and server-side rendering.
+     */
+    class HeadlessApplication : public ApplicationBase {
+        friend class HeadlessSystemWindow;
+
+    public:
+        void init() override;
+        void mainloop() override;
+        void open(std::shared_ptr<Window> window) override;
+        void close(std::shared_ptr<Window> window) override;
+        void shutdown() override;
+
+        /**
+         * Run a single iteration of the main loop
+         * Like in the other main loops, the due timers, posted tasks and frame callbacks run first,
+         * then the windows are drawn, in parallel when `setFrameThreads()` allows it, and only when
+         * they changed if the frame scheduler skips idle frames. `frameCount()` counts the frames.
+         * @return Number of windows shown, 0 ends the main loop
+         */
+        int step();
+
+        std::vector<SystemWindow *> systemWindows() const;
+
+        /**
+         * Get the headless system window of an open window
+         * @param window Window opened in this application
+         * @return System window, or nullptr if the window isn't open
+         */
+        HeadlessSystemWindow *systemWindow(const std::shared_ptr<Window> &window) const;
+
+    protected:
+        std::unordered_map<Window *, std::unique_ptr<HeadlessSystemWindow>> headlessWindows{};
+
+        bool running{false};
+    };
+
+    class HeadlessSystemWindow : public SystemWindow {
+        friend class HeadlessApplication;
+
+    public:
+        HeadlessSystemWindow(HeadlessApplication *application, std::shared_ptr<Window> window);
+        bool render() override;
+        bool hardwareAccelerated() const override;
+        void swapBuffers() override;
+
+        /**
+         * Number of frames presented so far
+         */
+        unsigned int frameCount() const;
+
+        // region Synthetic Input
+
+        void mouseMove(int x, int y);
+        void mouseDown(int x, int y, MouseButton button = MouseButton::LEFT);
+        void mouseUp(int x, int y, MouseButton button = MouseButton::LEFT);
+        void click(int x, int y, MouseButton button = MouseButton::LEFT);
+        void mouseScroll(int x, int y, double scrollX, double scrollY);
+        void keyDown(Key key, Mod modifiers = {});
+        void keyUp(Key key, Mod modifiers = {});
+        void type(const std::string &text);
+
+        // endregion
+
+        // region Read Back
+
+        /**
+         * Snapshot of the last rendered frame
+         */
+        sk_sp<SkImage> snapshot() const;
+
+        /**
+         * Copy the last rendered frame's pixels
+         * @param info Destination pixel format and size
+         * @param pixels Destination buffer
+         * @param rowBytes Size of a row in the destination buffer
+         * @return Whether the pixels could be read
+         */
+        bool readPixels(const SkImageInfo &info, void *pixels, size_t rowBytes) const;
+
+        /**
+         * Encode the last rendered frame as a PNG
+         */
+        sk_sp<SkData> encodePNG() const;
+
+        /**
+         * Save the last rendered frame as a PNG file
+         * @param path Destination file path
+         * @return Whether the file could be written
+         */
+        bool savePNG(const std::string &path) const;
+
+        // endregion
+
+    protected:
+        HeadlessApplication *_headlessApplication{nullptr};
+        unsigned int         _frameCount{0};
+        Mod                  _modifiers{};
+
+        void setTitle(const std::string &title) override;
+        void setFullscreen(bool fullscreen) override;
+        bool getMinimized() const override;
+        void setMinimized(bool minimized) override;
+        bool getMaximized() const override;
+        void setMaximized(bool maximized) override;
+        void setVisible(bool visible) override;
+        void setCursor(int cursor) override;
+        void startDrag() override;
+        void stopDrag() override;
+        void setSize(int width, int height) override;
+        void setPosition(int x, int y) override;
+    };
+}
@@ -1,8 +1,12 @@
 #ifdef WITH_SDL2
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <unicode/unistr.h>
 #include "SDL2Application.hpp"
+#include "../utils/Profiler.hpp"
+#include "../utils/Log.hpp"
 
 namespace psychic_ui {
 
@@ -12,7 +16,7 @@ namespace psychic_ui {
     * @param msg The error message to write, format will be msg error: SDL_GetError()
     */
     void logSDLError(const std::string &msg) {
-        std::cerr << msg << " error: " << SDL_GetError() << std::endl;
+        PSYCHIC_LOG_ERROR(msg << " error: " << SDL_GetError());
     }
 
     static int resizingEventWatcher(void *data, SDL_Event *event) {
@@ -39,6 +43,8 @@ namespace psychic_ui {
 
         // Event watch, cheat for live resize
         SDL_AddEventWatch(resizingEventWatcher, nullptr);
+
+        wakeUpEventType = SDL_RegisterEvents(1);
     }
 
     void SDL2Application::mainloop() {
@@ -49,27 +55,26 @@ namespace psychic_ui {
         running = true;
 
         while (running) {
-            sdl2PollEvents();
-
-            int       numScreens = 0;
-            for (auto &kv : sdl2Windows) {
-                if (kv.second->render()) {
-                    numScreens++;
-                }
-            }
+            // Block while there is nothing to draw, until an event comes or a timer is due
+            sdl2PollEvents(idleTimeout(systemWindows()));
 
-            // Cleanup dirty managers
-            for (auto &kv : sdl2Windows) {
-                kv.second->window()->styleManager()->setValid();
-            }
-
-            if (numScreens == 0) {
+            // Events can open and close windows
+            if (frame(systemWindows()) == 0) {
                 running = false;
                 break;
             }
         }
     }
 
+    std::vector<SystemWindow *> SDL2Application::systemWindows() const {
+        std::vector<SystemWindow *> windows{};
+        windows.reserve(sdl2Windows.size());
+        for (auto &kv : sdl2Windows) {
+            windows.push_back(kv.second.get());
+        }
+        return windows;
+    }
+
     void SDL2Application::open(std::shared_ptr<Window> window) {
         auto systemWindow = std::make_unique<SDL2SystemWindow>(this, window);
         sdl2Windows[SDL_GetWindowID(systemWindow->_sdl2Window)] = std::move(systemWindow);
@@ -79,38 +84,64 @@ namespace psychic_ui {
     }
 
     void SDL2Application::shutdown() {
+        releaseSharedContext();
         SDL_Quit();
     }
 
-    void SDL2Application::sdl2PollEvents() {
+    void SDL2Application::wakeUp() {
+        if (wakeUpEventType == 0 || wakeUpEventType == static_cast<uint32_t>(-1)) {
+            // Not initialized or no user events left
+            return;
+        }
         SDL_Event e{};
+        e.type = wakeUpEventType;
+        SDL_PushEvent(&e);
+    }
+
+    void SDL2Application::sdl2PollEvents(const std::chrono::microseconds timeout) {
+        SDL_Event e{};
+        if (timeout == std::chrono::microseconds::max()) {
+            if (SDL_WaitEvent(&e) != 0) {
+                sdl2HandleEvent(e);
+            }
+        } else if (timeout.count() > 0) {
+            // Rounded up, waking up early would only spin until the timer is due
+            auto milliseconds = std::min<int64_t>((timeout.count() + 999) / 1000, std::numeric_limits<int>::max());
+            if (SDL_WaitEventTimeout(&e, static_cast<int>(milliseconds)) != 0) {
+                sdl2HandleEvent(e);
+            }
+        }
         while (SDL_PollEvent(&e) != 0) {
-            switch (e.type) {
-                case SDL_QUIT: {
-                    running = false;
-                    break;
-                }
-                case SDL_WINDOWEVENT:
-                case SDL_KEYDOWN:
-                case SDL_KEYUP:
-                case SDL_TEXTINPUT:
-                case SDL_TEXTEDITING:
-                case SDL_MOUSEMOTION:
-                case SDL_MOUSEBUTTONDOWN:
-                case SDL_MOUSEBUTTONUP:
-                case SDL_MOUSEWHEEL: {
-                    auto res = sdl2Windows.find(e.window.windowID);
-                    if (res == sdl2Windows.cend()) {
-                        std::cerr << "Received an event for an unregistered window" << std::endl;
-                        break;
-                    }
-                    res->second->handleEvent(e);
+            sdl2HandleEvent(e);
+        }
+    }
+
+    void SDL2Application::sdl2HandleEvent(const SDL_Event &e) {
+        switch (e.type) {
+            case SDL_QUIT: {
+                running = false;
+                break;
+            }
+            case SDL_WINDOWEVENT:
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+            case SDL_TEXTINPUT:
+            case SDL_TEXTEDITING:
+            case SDL_MOUSEMOTION:
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP:
+            case SDL_MOUSEWHEEL: {
+                auto res = sdl2Windows.find(e.window.windowID);
+                if (res == sdl2Windows.cend()) {
+                    PSYCHIC_LOG_WARNING("Received an event for an unregistered window");
                     break;
                 }
-                default:
-                    break;
-
+                res->second->handleEvent(e);
+                break;
             }
+            default:
+                break;
+
         }
     }
 
@@ -192,6 +223,12 @@ namespace psychic_ui {
 
         // GL CONTEXT
 
+        // In shared context mode, join the share group of the current context, from the windows already opened
+        SDL_GL_SetAttribute(
+            SDL_GL_SHARE_WITH_CURRENT_CONTEXT,
+            application->sharedContext() && !SDL2Application::sdl2Windows.empty() ? 1 : 0
+        );
+
         _sdl2GlContext = SDL_GL_CreateContext(_sdl2Window);
         if (!_sdl2GlContext) {
             logSDLError("SDL_GL_CreateContext");
@@ -205,6 +242,7 @@ namespace psychic_ui {
             SDL_Quit();
             throw std::runtime_error("Could not make SDL2 GL context current!");
         }
+        activateContext();
 
         // Get Some info back about the framebuffer (in case its different from what we set?)
         //glGetFramebufferAttachmentParameteriv(
@@ -241,6 +279,9 @@ namespace psychic_ui {
     }
 
     SDL2SystemWindow::~SDL2SystemWindow() {
+        // The render thread can't be using the context when it goes away
+        _window->stopRenderThread();
+
         for (auto &_cursor : _cursors) {
             if (_cursor) {
                 SDL_FreeCursor(_cursor);
@@ -260,13 +301,43 @@ namespace psychic_ui {
             return false;
         }
 
+        PSYCHIC_PROFILE_FRAME();
+        {
+            PSYCHIC_PROFILE_SCOPE("input");
+            dispatchInput();
+        }
+        activateContext();
         _window->drawAll();
 
-        SDL_GL_SwapWindow(_sdl2Window);
+        if (!_window->renderThreadActive()) {
+            PSYCHIC_PROFILE_SCOPE("swap");
+            swapFrame();
+        }
+        framePresented();
 
         return true;
     }
 
+    void SDL2SystemWindow::makeContextCurrent() {
+        if (SDL_GL_MakeCurrent(_sdl2Window, _sdl2GlContext) != 0) {
+            logSDLError("SDL_GL_MakeCurrent");
+        }
+    }
+
+    void SDL2SystemWindow::releaseContext() {
+        SDL_GL_MakeCurrent(_sdl2Window, nullptr);
+    }
+
+    void SDL2SystemWindow::swapBuffers() {
+        SDL_GL_SwapWindow(_sdl2Window);
+    }
+
+    void SDL2SystemWindow::setSwapInterval(const int interval) {
+        if (SDL_GL_SetSwapInterval(interval) != 0) {
+            logSDLError("SDL_GL_SetSwapInterval");
+        }
+    }
+
     SDL_Window *SDL2SystemWindow::sdl2Window() const {
         return _sdl2Window;
     }
@@ -374,7 +445,7 @@ namespace psychic_ui {
                     case SDL_WINDOWEVENT_RESIZED:
                         _width  = e.window.data1;
                         _height = e.window.data2;
-                        _window->windowResized(_width, _height);
+                        resized();
                         break;
 
                     case SDL_WINDOWEVENT_SIZE_CHANGED:
@@ -411,7 +482,7 @@ namespace psychic_ui {
                         break;
 
                     case SDL_WINDOWEVENT_CLOSE:
-                        std::cerr << "No way to close?" << std::endl;
+                        PSYCHIC_LOG_WARNING("No way to close?");
                         break;
 
                     //(>= SDL 2.0.5)
@@ -429,18 +500,18 @@ namespace psychic_ui {
 
             case SDL_KEYDOWN:
                 if (e.key.repeat) {
-                    _window->keyRepeat(mapKey(e.key.keysym.sym), mapMods(e.key.keysym.mod));
+                    queueInput(InputEvent::keyRepeat(mapKey(e.key.keysym.sym), mapMods(e.key.keysym.mod)));
                 } else {
-                    _window->keyDown(mapKey(e.key.keysym.sym), mapMods(e.key.keysym.mod));
+                    queueInput(InputEvent::keyDown(mapKey(e.key.keysym.sym), mapMods(e.key.keysym.mod)));
                 }
                 break;
 
             case SDL_KEYUP:
-                _window->keyUp(mapKey(e.key.keysym.sym), mapMods(e.key.keysym.mod));
+                queueInput(InputEvent::keyUp(mapKey(e.key.keysym.sym), mapMods(e.key.keysym.mod)));
                 break;
 
             case SDL_TEXTINPUT:
-                _window->keyboardCharacterEvent(icu::UnicodeString::fromUTF8(e.text.text));
+                queueInput(InputEvent::characterInput(icu::UnicodeString::fromUTF8(e.text.text)));
                 break;
 
             case SDL_MOUSEMOTION:
@@ -456,7 +527,7 @@ namespace psychic_ui {
                     SDL_SetWindowPosition(_sdl2Window, _x + _windowDragOffsetX, _y + _windowDragOffsetY);
                 }
 
-                _window->mouseMoved(_mouseX, _mouseY, _mouseState, mapMods(SDL_GetModState()), false);
+                queueInput(InputEvent::mouseMove(_mouseX, _mouseY, _mouseState, mapMods(SDL_GetModState())));
                 break;
 
             case SDL_MOUSEBUTTONDOWN: {
@@ -471,7 +542,7 @@ namespace psychic_ui {
                     break;
                 }
                 _mouseState |= 1 << btn;
-                _window->mouseButton(_mouseX, _mouseY, btn, true, mapMods(SDL_GetModState()));
+                queueInput(InputEvent::mouseButton(_mouseX, _mouseY, btn, true, mapMods(SDL_GetModState())));
                 //_window->mouseDown(_mouseX, _mouseY, btn, mapMods(SDL_GetModState()));
                 break;
             }
@@ -488,14 +559,14 @@ namespace psychic_ui {
                     break;
                 }
                 _mouseState &= ~btn;
-                _window->mouseButton(_mouseX, _mouseY, btn, false, mapMods(SDL_GetModState()));
+                queueInput(InputEvent::mouseButton(_mouseX, _mouseY, btn, false, mapMods(SDL_GetModState())));
                 //_window->click(_mouseX, _mouseY, btn, mapMods(SDL_GetModState()));
                 //_window->mouseUp(_mouseX, _mouseY, btn, mapMods(SDL_GetModState()));
                 break;
             }
 
             case SDL_MOUSEWHEEL:
-                _window->mouseScrolled(_mouseX, _mouseY, e.wheel.x, e.wheel.y);
+                queueInput(InputEvent::mouseScroll(_mouseX, _mouseY, e.wheel.x, e.wheel.y));
                 break;
 
             default:
@@ -506,7 +577,7 @@ namespace psychic_ui {
     void SDL2SystemWindow::liveResize(int width, int height) {
         _width  = width;
         _height = height;
-        _window->windowResized(_width, _height);
+        resized();
         render();
     }
 
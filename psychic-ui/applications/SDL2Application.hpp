@@ -38,7 +38,18 @@ namespace psychic_ui {
         void shutdown() override;
     protected:
         bool running{false};
-        void sdl2PollEvents();
+        /**
+         * Handle the pending events, waiting up to `timeout` for one if there is none
+         */
+        void sdl2PollEvents(std::chrono::microseconds timeout = std::chrono::microseconds{0});
+        void sdl2HandleEvent(const SDL_Event &e);
+        std::vector<SystemWindow *> systemWindows() const;
+
+        /**
+         * Event type used to wake the event loop when tasks are posted
+         */
+        uint32_t wakeUpEventType{0};
+        void wakeUp() override;
     };
 
     class SDL2SystemWindow : public SystemWindow {
@@ -51,6 +62,11 @@ namespace psychic_ui {
         void handleEvent(const SDL_Event &e);
         void liveResize(int width, int height);
         bool render() override;
+        void makeContextCurrent() override;
+        void releaseContext() override;
+        void swapBuffers() override;
+        void setSwapInterval(int interval) override;
+
     protected:
         SDL2Application *_sdl2Application{nullptr};
         SDL_Window      *_sdl2Window{nullptr};
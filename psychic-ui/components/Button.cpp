@@ -48,7 +48,12 @@ namespace psychic_ui {
 
     void Button::setLabel(const std::string &label) {
         _label = label;
-        _skin->setLabel(_label);
+        if (_skin) {
+            _skin->setLabel(_label);
+        } else {
+            // Renderers read the label when drawing
+            invalidateRenderCache();
+        }
     }
 
     bool Button::selected() const {
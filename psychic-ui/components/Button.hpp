@@ -17,6 +17,11 @@ namespace psychic_ui {
         }
 
         virtual void setLabel(const std::string &/*label*/) {};
+
+        void reset() override {
+            setLabel("");
+            Skin<Button>::reset();
+        }
     };
 
     class Button : public Component<ButtonSkin> {
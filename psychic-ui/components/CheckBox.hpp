@@ -18,6 +18,11 @@ namespace psychic_ui {
         }
 
         virtual void setLabel(const std::string &/*label*/) {};
+
+        void reset() override {
+            setLabel("");
+            Skin<CheckBox>::reset();
+        }
     };
 
     class CheckBox : public Component<CheckBoxSkin> {
@@ -47,6 +47,8 @@ namespace psychic_ui {
         if (data != _data) {
             _data = data;
             _dataChanged = true;
+            // Children are rebuilt when rendering, cached ancestors would never get there
+            invalidateRenderCache();
         }
         return this;
     }
@@ -66,7 +66,6 @@ namespace psychic_ui {
         bool  enabled        = false;
 
         if (_direction == Vertical) {
-             std::cout << "scroll " << _viewport->contentHeight() << " " << _viewport->contentHeight() << " " << _viewport->getHeight() << std::endl;
             if (_viewport && _viewport->contentHeight() > 0 && _viewport->contentHeight() > _viewport->getHeight()) {
                 _viewport->setScrollY(
                     std::max(_viewport->scrollY(), _viewport->getHeight() - _viewport->contentHeight())
@@ -1,5 +1,6 @@
 #include <SkRegion.h>
 #include "psychic-ui/utils/StringUtils.hpp"
+#include "psychic-ui/utils/Log.hpp"
 #include "psychic-ui/Window.hpp"
 #include "Text.hpp"
 
@@ -34,6 +35,7 @@ namespace psychic_ui {
         _caret       = 0;
         _selectBegin = 0;
         _selectEnd   = 0;
+        invalidateRenderCache();
         return this;
     }
 
@@ -93,6 +95,7 @@ namespace psychic_ui {
         if (_selectBegin > _selectEnd) {
             std::swap(_selectBegin, _selectEnd);
         }
+        invalidateRenderCache();
 
         onCaret(_selectEnd);
         onSelection(_selectBegin, _selectEnd);
@@ -111,11 +114,12 @@ namespace psychic_ui {
         if (saveX) {
             _targetXPos = _textBox.posFromIndex(_caret).second;
         }
+        invalidateRenderCache();
         if (isValid()) {
-            std::cout << "on caret is valid" << std::endl;
+            PSYCHIC_LOG_TRACE("on caret is valid");
             onCaret(_caret);
         } else {
-            std::cout << "on caret pending" << std::endl;
+            PSYCHIC_LOG_TRACE("on caret pending");
 
             // Wait until the layout is valid to notify,
             // otherwise the caret position won't be correct.
@@ -150,6 +154,7 @@ namespace psychic_ui {
                             _selectBegin = _caret;
                             _selectEnd   = initialBegin;
                         }
+                        invalidateRenderCache();
                         onCaret(_caret);
                         onSelection(_selectBegin, _selectEnd);
                     }
@@ -180,6 +185,7 @@ namespace psychic_ui {
                     _selectBegin = 0;
                     _selectEnd   = static_cast<unsigned int>(_text.length());
                 }
+                invalidateRenderCache();
                 onSelection(_selectBegin, _selectEnd);
             }
         );
@@ -257,6 +263,7 @@ namespace psychic_ui {
                 if (mod.ctrl or mod.super) {
                     _selectBegin = 0;
                     _selectEnd   = static_cast<unsigned int>(_text.length());
+                    invalidateRenderCache();
                     onSelection(_selectBegin, _selectEnd);
                 }
                 break;
@@ -425,9 +432,9 @@ namespace psychic_ui {
         TextBase::layoutUpdated();
         _textBox.setBox(0.0f, 0.0f, _paddedRect.width(), _paddedRect.height());
         _blob = _textBox.snapshotTextBlob();
-        std::cout << "layout" << std::endl;
+        PSYCHIC_LOG_TRACE("layout");
         if (_pendingCaretSignal) {
-            std::cout << "on caret" << std::endl;
+            PSYCHIC_LOG_TRACE("on caret");
             onCaret(_caret);
             _pendingCaretSignal = false;
         }
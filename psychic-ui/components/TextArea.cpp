@@ -1,4 +1,5 @@
 #include "TextArea.hpp"
+#include "../utils/Log.hpp"
 
 namespace psychic_ui {
 
@@ -29,12 +30,13 @@ namespace psychic_ui {
                 int yOver  = (line + 1) * _textDisplay->getLineHeight();
                 int yUnder = line * _textDisplay->getLineHeight();
 
-                std::cout << line << " " << yOver << " " << yUnder << " " << _textScroller->viewport()->scrollY() << " " << _textScroller->viewport()->getHeight() << std::endl;
+                PSYCHIC_LOG_TRACE(
+                    "Caret line " << line << " " << yOver << " " << yUnder << " "
+                                  << _textScroller->viewport()->scrollY() << " " << _textScroller->viewport()->getHeight()
+                );
 
                 if (yOver > -_textScroller->viewport()->scrollY() + _textScroller->viewport()->getHeight()) {
-                    std::cout << -(yOver - _textScroller->viewport()->getHeight()) << std::endl;
                     _textScroller->viewport()->setScrollY(-(yOver - _textScroller->viewport()->getHeight()));
-                    std::cout << _textScroller->viewport()->scrollY() << " " << _textScroller->viewport()->getHeight() << std::endl;
                 } else if (yUnder < -_textScroller->viewport()->scrollY()) {
                     _textScroller->viewport()->setScrollY(-(yUnder));
                 }
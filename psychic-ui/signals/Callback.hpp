@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace psychic_ui {
+
+    template<class Signature>
+    class Callback;
+
+    /**
+     * Callback
+     * Move-only replacement for `std::function` used by the signal slots.
+     * Callables small enough to fit in the inline buffer (lambdas capturing a few pointers
+     * or references, which covers nearly every subscription in the library) are stored
+     * in place, larger ones fall back to a single heap allocation.
+     */
+    template<class R, class... Args>
+    class Callback<R(Args...)> {
+    public:
+        static constexpr std::size_t inlineSize = 4 * sizeof(void *);
+
+        Callback() = default;
+
+        Callback(std::nullptr_t) {}
+
+        template<
+            class F,
+            class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Callback>::value>::type,
+            class = decltype(std::declval<typename std::decay<F>::type &>()(std::declval<Args>()...))
+        >
+        Callback(F &&callable) {
+            emplace<typename std::decay<F>::type>(std::forward<F>(callable));
+        }
+
+        Callback(Callback &&other) noexcept {
+            moveFrom(other);
+        }
+
+        Callback &operator=(Callback &&other) noexcept {
+            if (this != &other) {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        Callback(const Callback &) = delete;
+        Callback &operator=(const Callback &) = delete;
+
+        ~Callback() {
+            reset();
+        }
+
+        explicit operator bool() const {
+            return _invoke != nullptr;
+        }
+
+        R operator()(Args... args) const {
+            return _invoke(const_cast<void *>(static_cast<const void *>(&_storage)), std::forward<Args>(args)...);
+        }
+
+        void reset() {
+            if (_manage) {
+                _manage(Operation::Destroy, &_storage, nullptr);
+            }
+            _invoke = nullptr;
+            _manage = nullptr;
+        }
+
+    protected:
+        enum class Operation {
+            Move,
+            Destroy
+        };
+
+        using Storage = typename std::aligned_storage<inlineSize, alignof(void *)>::type;
+
+        Storage _storage;
+        R (*_invoke)(void *, Args &&...){nullptr};
+        void (*_manage)(Operation, void *, void *){nullptr};
+
+        template<class F>
+        using StoredInline = std::integral_constant<
+            bool,
+            sizeof(F) <= inlineSize
+            && alignof(void *) % alignof(F) == 0
+            && std::is_nothrow_move_constructible<F>::value
+        >;
+
+        template<class F, class C>
+        void emplace(C &&callable) {
+            emplace<F>(std::forward<C>(callable), StoredInline<F>{});
+        }
+
+        template<class F, class C>
+        void emplace(C &&callable, std::true_type) {
+            ::new(static_cast<void *>(&_storage)) F(std::forward<C>(callable));
+            _invoke = [](void *storage, Args &&... args) -> R {
+                return (*static_cast<F *>(storage))(std::forward<Args>(args)...);
+            };
+            _manage = [](Operation operation, void *storage, void *source) {
+                if (operation == Operation::Move) {
+                    ::new(storage) F(std::move(*static_cast<F *>(source)));
+                }
+                // Moved from callables get destroyed as well
+                static_cast<F *>(operation == Operation::Move ? source : storage)->~F();
+            };
+        }
+
+        template<class F, class C>
+        void emplace(C &&callable, std::false_type) {
+            ::new(static_cast<void *>(&_storage)) F *(new F(std::forward<C>(callable)));
+            _invoke = [](void *storage, Args &&... args) -> R {
+                return (**static_cast<F **>(storage))(std::forward<Args>(args)...);
+            };
+            _manage = [](Operation operation, void *storage, void *source) {
+                if (operation == Operation::Move) {
+                    ::new(storage) F *(*static_cast<F **>(source));
+                } else {
+                    delete *static_cast<F **>(storage);
+                }
+            };
+        }
+
+        void moveFrom(Callback &other) {
+            if (other._manage) {
+                other._manage(Operation::Move, &_storage, &other._storage);
+            }
+            _invoke = other._invoke;
+            _manage = other._manage;
+            other._invoke = nullptr;
+            other._manage = nullptr;
+        }
+    };
+
+}
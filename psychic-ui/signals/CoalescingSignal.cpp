@@ -0,0 +1,84 @@
+#include <algorithm>
+#include "CoalescingSignal.hpp"
+
+namespace psychic_ui {
+
+    /**
+     * Maximum number of passes when delivered slots keep emitting,
+     * whatever is left is delivered on the next frame
+     */
+    static const int maxFlushPasses = 8;
+
+    CoalescingSignalBase::~CoalescingSignalBase() {
+        std::lock_guard<std::mutex> lock(mutex());
+        if (_scheduled) {
+            auto &list = pending();
+            list.erase(std::remove(list.begin(), list.end(), this), list.end());
+        }
+        // We might be destroyed by a slot while signals are being delivered
+        auto &list = delivering();
+        std::replace(list.begin(), list.end(), this, static_cast<CoalescingSignalBase *>(nullptr));
+    }
+
+    void CoalescingSignalBase::schedule() {
+        if (!_scheduled) {
+            _scheduled = true;
+            pending().push_back(this);
+        }
+    }
+
+    std::mutex &CoalescingSignalBase::mutex() {
+        static std::mutex mutex{};
+        return mutex;
+    }
+
+    std::vector<CoalescingSignalBase *> &CoalescingSignalBase::pending() {
+        static std::vector<CoalescingSignalBase *> signals{};
+        return signals;
+    }
+
+    std::vector<CoalescingSignalBase *> &CoalescingSignalBase::delivering() {
+        static std::vector<CoalescingSignalBase *> signals{};
+        return signals;
+    }
+
+    void CoalescingSignalBase::flushAll() {
+        // Main thread only, the lock is released while the slots run since they can emit
+        auto &list = delivering();
+        for (int pass = 0; pass < maxFlushPasses; ++pass) {
+            {
+                std::lock_guard<std::mutex> lock(mutex());
+                list.clear();
+                if (pending().empty()) {
+                    break;
+                }
+                std::swap(list, pending());
+                // Unschedule everything first so that signals emitted from slots get scheduled again
+                for (auto signal: list) {
+                    signal->_scheduled = false;
+                }
+            }
+            for (std::size_t i = 0;; ++i) {
+                CoalescingSignalBase *signal;
+                {
+                    // Signals destroyed by the slots are removed from the list
+                    std::lock_guard<std::mutex> lock(mutex());
+                    if (i >= list.size()) {
+                        break;
+                    }
+                    signal = list[i];
+                }
+                if (signal) {
+                    signal->flush();
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex());
+        list.clear();
+    }
+
+    bool CoalescingSignalBase::hasPending() {
+        std::lock_guard<std::mutex> lock(mutex());
+        return !pending().empty();
+    }
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Signal.hpp"
+
+namespace psychic_ui {
+
+    /**
+     * Base of the coalescing signals, keeps track of the signals waiting to be delivered
+     */
+    class CoalescingSignalBase {
+    public:
+        virtual ~CoalescingSignalBase();
+
+        /**
+         * Deliver the pending emission, if any
+         */
+        virtual void flush() = 0;
+
+        /**
+         * Deliver every pending coalesced emission
+         * Called once per frame by the window, before style and layout. Emissions
+         * triggered by the delivered slots are delivered in the same pass.
+         */
+        static void flushAll();
+
+        /**
+         * Whether any coalesced emission is waiting to be delivered
+         */
+        static bool hasPending();
+
+    protected:
+        bool _scheduled{false};
+
+        /**
+         * Add to the pending signals, the mutex must be held
+         */
+        void schedule();
+        /**
+         * Guards the pending lists and the pending emissions
+         * Style and layout slots run on the frame threads and can emit while windows are recorded.
+         */
+        static std::mutex &mutex();
+        static std::vector<CoalescingSignalBase *> &pending();
+        static std::vector<CoalescingSignalBase *> &delivering();
+    };
+
+    /**
+     * Coalescing Signal
+     * Works like a Signal but emitting only stores the arguments, slots are notified
+     * once per frame with the latest arguments. An optional reducer can merge the
+     * arguments of successive emissions instead of keeping only the latest ones.
+     * Emitting is thread safe, slots are always notified on the main thread. Reducers
+     * run while emitting and must not emit themselves.
+     */
+    template<class... T>
+    class CoalescingSignal : public Signal<T...>, public CoalescingSignalBase {
+    public:
+        using Arguments = std::tuple<typename std::decay<T>::type...>;
+        using Reducer = std::function<Arguments(const Arguments &pending, const Arguments &incoming)>;
+
+        CoalescingSignal() = default;
+
+        explicit CoalescingSignal(Reducer reducer) :
+            _reducer(std::move(reducer)) {}
+
+        /**
+         * Store the arguments until the next frame
+         * @param args Arguments matching the types used as template arguments
+         */
+        void emit(T &... args) {
+            Arguments                   incoming{args...};
+            std::lock_guard<std::mutex> lock(mutex());
+            if (_hasPending && _reducer) {
+                _pending = _reducer(_pending, incoming);
+            } else {
+                _pending = std::move(incoming);
+            }
+            _hasPending = true;
+            schedule();
+        }
+
+        void operator()(T &... args) {
+            emit(args...);
+        }
+
+        using Signal<T...>::operator();
+
+        /**
+         * Notify the slots right away, dropping any pending emission
+         * @param args Arguments matching the types used as template arguments
+         */
+        void emitNow(T &... args) {
+            {
+                std::lock_guard<std::mutex> lock(mutex());
+                _hasPending = false;
+            }
+            Signal<T...>::emit(args...);
+        }
+
+        bool hasPendingEmission() const {
+            std::lock_guard<std::mutex> lock(mutex());
+            return _hasPending;
+        }
+
+        void flush() override {
+            Arguments arguments{};
+            {
+                std::lock_guard<std::mutex> lock(mutex());
+                if (!_hasPending) {
+                    return;
+                }
+                _hasPending = false;
+                arguments = std::move(_pending);
+            }
+            // Slots can emit again
+            deliver(arguments, std::index_sequence_for<T...>{});
+        }
+
+    protected:
+        Reducer   _reducer{nullptr};
+        Arguments _pending{};
+        bool      _hasPending{false};
+
+        template<std::size_t... I>
+        void deliver(Arguments &arguments, std::index_sequence<I...>) {
+            Signal<T...>::emit(std::get<I>(arguments)...);
+        }
+    };
+
+}
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <functional>
-#include <vector>
+#include <memory>
+#include "Callback.hpp"
 #include "Signal.hpp"
 #include "Slot.hpp"
 
@@ -13,43 +13,59 @@ namespace psychic_ui {
      */
     template<typename... T>
     struct Identity {
-        typedef std::function<void(T...)> type;
+        typedef Callback<void(T...)> type;
     };
 
     /**
      * Extend from Observer and use `subscribeTo` in order to remove subscriptions automatically.
      * Useful in cases when the subclass' life is shorter than that of the signal.
+     * Subscriptions are chained through the slots themselves, an observer that never
+     * subscribes to anything only costs an empty pointer.
      */
     class Observer {
     public:
         Observer() = default;
 
         ~Observer() {
-            for (auto &slot: slots) {
+            auto slot = std::move(_observedSlots);
+            while (slot) {
                 slot->disconnect();
+                auto next = std::move(slot->_nextObserved);
+                slot = std::move(next);
             }
-            slots.clear();
         }
 
     protected:
-        std::vector<std::shared_ptr<SlotBase>> slots{};
-
         /**
          * Subscribe this observer to a signal
          * Use this method when you know the the signal will outlive you.
          */
         template<class... T>
         std::shared_ptr<Slot<T...>> subscribeTo(Signal<T...> &signal, typename Identity<T...>::type &&callback) {
-            auto slot = signal.subscribe(std::forward<std::function<void(T...)>>(callback));
-            slots.push_back(slot);
+            auto slot = signal.subscribe(std::move(callback));
+            slot->_nextObserved = std::move(_observedSlots);
+            _observedSlots = slot;
             return slot;
         }
 
         template<class... T>
         void unsubscribeFrom(std::shared_ptr<SlotBase> slot) {
+            if (!slot) {
+                return;
+            }
             slot->disconnect();
-            slots.erase(std::remove(slots.begin(), slots.end(), slot), slots.end());
+            std::shared_ptr<SlotBase> *link = &_observedSlots;
+            while (*link) {
+                if (*link == slot) {
+                    *link = std::move(slot->_nextObserved);
+                    return;
+                }
+                link = &(*link)->_nextObserved;
+            }
         }
+
+    private:
+        std::shared_ptr<SlotBase> _observedSlots{nullptr};
     };
 
 }
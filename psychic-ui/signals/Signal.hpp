@@ -1,10 +1,9 @@
 #pragma once
 
-#include <algorithm>
 #include <functional>
-#include <vector>
 #include <memory>
 
+#include "Callback.hpp"
 #include "Slot.hpp"
 
 namespace psychic_ui {
@@ -13,24 +12,33 @@ namespace psychic_ui {
      * Signal
      * Create a signal with template arguments matching the arguments required for `emit` and parameters that will be
      * used in the callback/lambda.
+     *
+     * A signal without subscriptions is a single null pointer, its slot list is only allocated on the first
+     * subscription and released when the last slot goes away. Slots can unsubscribe (themselves or others)
+     * while the signal is being emitted, they are skipped and removed from the list once the emission is over.
+     * Slots subscribed while the signal is being emitted are only notified on the next emission.
      */
 
     template<class... T>
     class Signal {
     public:
+        Signal() = default;
+        Signal(const Signal &) = delete;
+        Signal &operator=(const Signal &) = delete;
+        ~Signal();
 
         /**
          * Check if the signal has any subscriptions
          */
         bool hasSubscriptions() const {
-            return !slots.empty();
+            return _storage && _storage->count > 0;
         }
 
         /**
          * Get the number of subscriptions
          */
         std::size_t subscriptionCount() const {
-            return slots.size();
+            return _storage ? _storage->count : 0;
         }
 
         /**
@@ -38,7 +46,7 @@ namespace psychic_ui {
          * Use this method when you know that you will outlive the signal, otherwise, you have to keep the returned
          * shared pointer and unsubscribe manually. For automatic cleanup, extend from Observer and use its methods.
          */
-        std::shared_ptr<Slot<T...>> subscribe(std::function<void(T...)> &&callback);
+        std::shared_ptr<Slot<T...>> subscribe(Callback<void(T...)> &&callback);
 
         /**
          * Unsubscribe from this signal
@@ -57,7 +65,6 @@ namespace psychic_ui {
          * @param args Arguments matching the types used as template arguments
          */
         void operator()(T &... args) {
-//            emit(std::forward<T...>(args)...);
             emit(args...);
         }
 
@@ -66,44 +73,139 @@ namespace psychic_ui {
          * Use this method when you know that you will outlive the signal, otherwise, you have to keep the returned
          * shared pointer and unsubscribe manually. For automatic cleanup, extend from Observer and use its methods.
          */
-        std::shared_ptr<Slot<T...>> operator()(std::function<void(T...)> &&callback) {
-            return subscribe(std::forward<std::function<void(T...)>>(callback));
+        std::shared_ptr<Slot<T...>> operator()(Callback<void(T...)> &&callback) {
+            return subscribe(std::move(callback));
         }
 
     protected:
-        std::vector<std::shared_ptr<Slot<T...>>> slots{};
+        /**
+         * Intrusive list of slots, only allocated while the signal has subscriptions
+         */
+        struct Storage {
+            Slot<T...>  *head{nullptr};
+            Slot<T...>  *tail{nullptr};
+            std::size_t count{0};
+            unsigned    emitting{0};
+            bool        dirty{false};
+        };
+
+        std::unique_ptr<Storage> _storage{nullptr};
+
+        void unlink(Slot<T...> *slot);
+        void sweep();
     };
 
     template<class... T>
-    std::shared_ptr<Slot<T...>> Signal<T...>::subscribe(std::function<void(T...)> &&callback) {
-        auto slot = std::make_shared<Slot<T...>>(this, std::forward<std::function<void(T...)>>(callback));
-        slots.push_back(slot);
+    Signal<T...>::~Signal() {
+        if (!_storage) {
+            return;
+        }
+        Slot<T...> *slot = _storage->head;
+        while (slot) {
+            Slot<T...> *next = slot->_next;
+            slot->_signal   = nullptr;
+            slot->_previous = nullptr;
+            slot->_next     = nullptr;
+            // Might destroy the slot, so it has to be the last thing we touch
+            auto self = std::move(slot->_self);
+            slot = next;
+        }
+    }
+
+    template<class... T>
+    std::shared_ptr<Slot<T...>> Signal<T...>::subscribe(Callback<void(T...)> &&callback) {
+        auto slot = std::make_shared<Slot<T...>>(this, std::move(callback));
+        if (!_storage) {
+            _storage = std::make_unique<Storage>();
+        }
+        slot->_previous = _storage->tail;
+        if (_storage->tail) {
+            _storage->tail->_next = slot.get();
+        } else {
+            _storage->head = slot.get();
+        }
+        _storage->tail = slot.get();
+        slot->_self    = slot;
+        ++_storage->count;
         return slot;
     }
 
     template<class... T>
     void Signal<T...>::unsubscribe(std::shared_ptr<Slot<T...>> slot) {
-        slots.erase(std::remove(slots.begin(), slots.end(), slot), slots.end());
+        unsubscribe(slot.get());
     }
 
     template<class... T>
     void Signal<T...>::unsubscribe(const Slot<T...> *slot) {
-        slots.erase(
-            std::remove_if(
-                slots.begin(),
-                slots.end(),
-                [slot](const std::shared_ptr<Slot<T...>> &s) {
-                    return s.get() == slot;
-                }
-            ),
-            slots.end()
-        );
+        if (!slot || slot->_signal != this) {
+            return;
+        }
+        auto s = const_cast<Slot<T...> *>(slot);
+        s->_signal = nullptr;
+        --_storage->count;
+        if (_storage->emitting > 0) {
+            // Keep it in the list until the emission is over, emit skips disconnected slots
+            _storage->dirty = true;
+        } else {
+            unlink(s);
+            if (!_storage->head) {
+                _storage.reset();
+            }
+        }
     }
 
     template<class... T>
     void Signal<T...>::emit(T &... args) {
-        for (auto &slot: slots) {
-            slot->notify(args...);
+        if (!_storage) {
+            return;
+        }
+        Storage    &storage = *_storage;
+        Slot<T...> *last    = storage.tail;
+        ++storage.emitting;
+        for (Slot<T...> *slot = storage.head; slot; slot = slot->_next) {
+            if (slot->_signal) {
+                slot->notify(args...);
+            }
+            if (slot == last) {
+                break;
+            }
+        }
+        if (--storage.emitting == 0 && storage.dirty) {
+            sweep();
+        }
+    }
+
+    template<class... T>
+    void Signal<T...>::unlink(Slot<T...> *slot) {
+        if (slot->_previous) {
+            slot->_previous->_next = slot->_next;
+        } else {
+            _storage->head = slot->_next;
+        }
+        if (slot->_next) {
+            slot->_next->_previous = slot->_previous;
+        } else {
+            _storage->tail = slot->_previous;
+        }
+        slot->_previous = nullptr;
+        slot->_next     = nullptr;
+        // Might destroy the slot, so it has to be the last thing we touch
+        auto self = std::move(slot->_self);
+    }
+
+    template<class... T>
+    void Signal<T...>::sweep() {
+        _storage->dirty = false;
+        Slot<T...> *slot = _storage->head;
+        while (slot) {
+            Slot<T...> *next = slot->_next;
+            if (!slot->_signal) {
+                unlink(slot);
+            }
+            slot = next;
+        }
+        if (!_storage->head) {
+            _storage.reset();
         }
     }
 
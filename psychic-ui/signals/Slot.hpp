@@ -1,21 +1,35 @@
 #pragma once
 
-#include <functional>
+#include <memory>
+#include "Callback.hpp"
 
 namespace psychic_ui {
 
     template<class... T>
     class Signal;
 
+    class Observer;
+
     /**
      * Base Subscription, just so that we can store it in the Observer
      */
     class SlotBase {
     public:
+        virtual ~SlotBase() = default;
+
         /**
          * Disconnects this slot, removing it from the signal
          */
         virtual void disconnect() = 0;
+
+    private:
+        friend class Observer;
+
+        /**
+         * Next slot subscribed by the same observer
+         * Observers keep their subscriptions in an intrusive list instead of a vector.
+         */
+        std::shared_ptr<SlotBase> _nextObserved{nullptr};
     };
 
     /**
@@ -25,11 +39,14 @@ namespace psychic_ui {
      * derived class in order to automatically clean subscriptions in scenarios where
      * the Observer has a shorter life span than the Signal source. When a Signal
      * source has a shorter life, there is no need to hold a pointer to the slot as
-     * the Signal will be destroyed first, thus destroying the slots and their callbacks.
+     * the Signal will be destroyed first, disconnecting the slots.
      *
      * When keeping a pointer to a slot for manual disconnection, type the Slot template
      * with the same type parameters as the Signal. For example, a `Signal<float, int>` will
      * return a `shared_ptr<Slot<float, int>>` when subscribing.
+     *
+     * Slots are the nodes of the intrusive list kept by their Signal, subscribing only
+     * costs the allocation of the slot itself.
      */
     template<class... T>
     class Slot : public SlotBase {
@@ -45,18 +62,27 @@ namespace psychic_ui {
          * @param signal Signal that this slot is attached to
          * @param callback Callback to execute when the signal is emited
          */
-        explicit Slot(Signal<T...> *signal, std::function<void(T...)> callback) :
-            notify(callback),
+        explicit Slot(Signal<T...> *signal, Callback<void(T...)> &&callback) :
+            notify(std::move(callback)),
             _signal(signal) {}
 
         /**
          * Disconnect the slot
          * This will unsubscribe from the signal, effectively removing this
-         * slot from the vector in the Signal instance.
+         * slot from the list in the Signal instance. Disconnecting a slot
+         * whose signal was already destroyed does nothing.
          */
         void disconnect() override {
-            _signal->unsubscribe(this);
-            _signal = nullptr;
+            if (_signal) {
+                _signal->unsubscribe(this);
+            }
+        }
+
+        /**
+         * Whether the slot is still subscribed to its signal
+         */
+        bool connected() const {
+            return _signal != nullptr;
         }
 
         /**
@@ -64,14 +90,25 @@ namespace psychic_ui {
          * This should not be called manually, it is called by
          * the Signal class
          */
-        std::function<void(T...)> notify{nullptr};
+        Callback<void(T...)> notify{nullptr};
 
     private:
+        friend class Signal<T...>;
+
         /**
          * Signal that owns this slot
-         * This pointer is used to allow disconnecting from the slot.
+         * This pointer is used to allow disconnecting from the slot,
+         * it is cleared when disconnecting or when the signal is destroyed.
+         */
+        Signal<T...> *_signal{nullptr};
+
+        Slot *_previous{nullptr};
+        Slot *_next{nullptr};
+
+        /**
+         * Reference held by the signal for as long as the slot is in its list
          */
-        Signal<T...> *_signal;
+        std::shared_ptr<Slot> _self{nullptr};
     };
 
 }
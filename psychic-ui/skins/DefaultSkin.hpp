@@ -37,9 +37,6 @@ namespace psychic_ui {
             paint.setAntiAlias(style->get(antiAlias));
             paint.setStyle(SkPaint::kFill_Style);
             paint.setColor(style->get(contentBackgroundColor));
-            if (style->has(opacity)) {
-                paint.setAlpha((unsigned int) (style->get(opacity) * 255.f));
-            }
 
             // Paint background
             SkRRect inside = rect;
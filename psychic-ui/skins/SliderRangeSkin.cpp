@@ -110,6 +110,7 @@ namespace psychic_ui {
             removeClassName("inverted");
         }
         _valueLabel->setText(component()->valueString());
+        invalidateRenderCache();
     }
 
     void SliderRangeSkin::sendMouseValue(const int x, const int y) {
@@ -2,17 +2,10 @@
 #include "TitleBarButtonSkin.hpp"
 
 namespace psychic_ui {
-    TitleBarButtonSkin::TitleBarButtonSkin() :
-        ButtonSkin() {
-        setTag("TitleBarButtonSkin");
-        style()
-            ->set(widthPercent, 1.0f)
-            ->set(heightPercent, 1.0f);
-    }
 
-    void TitleBarButtonSkin::draw(SkCanvas *canvas) {
-        int hw = _width / 2;
-        int hh = _height / 2;
+    void TitleBarButtonSkin::drawComponent(Button *component, SkCanvas *canvas) {
+        int hw = component->getWidth() / 2;
+        int hh = component->getHeight() / 2;
 
         SkPaint paint;
         paint.setAntiAlias(true);
@@ -25,7 +18,7 @@ namespace psychic_ui {
         canvas->drawCircle(hw, hh, hw - 1, paint);
 
         paint.setStyle(SkPaint::kFill_Style);
-        paint.setColor(component()->computedStyle()->get(backgroundColor));
+        paint.setColor(component->computedStyle()->get(backgroundColor));
         canvas->drawCircle(hw, hh, hw - 2, paint);
     }
 
@@ -4,11 +4,11 @@
 #include "../components/Button.hpp"
 
 namespace psychic_ui {
-    class TitleBarButtonSkin : public ButtonSkin {
-    public:
-        TitleBarButtonSkin();
+    /**
+     * Title bar buttons only draw chrome, so a single renderer is shared by all of them
+     */
+    class TitleBarButtonSkin : public SkinRenderer<Button> {
     protected:
-        void draw(SkCanvas *canvas);
+        void drawComponent(Button *component, SkCanvas *canvas) override;
     };
 }
-
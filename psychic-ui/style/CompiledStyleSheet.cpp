@@ -0,0 +1,260 @@
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PSYCHIC_UI_MMAP
+#endif
+
+#include "CompiledStyleSheet.hpp"
+#include "StyleManager.hpp"
+#include "../utils/BinaryData.hpp"
+
+namespace psychic_ui {
+
+    const uint32_t CompiledStyleSheet::version = 1;
+
+    namespace {
+
+        /**
+         * Layout:
+         *   header (see BinaryWriter::writeHeader), declaration count, string table size
+         *   string table (null terminated strings, referenced by offset)
+         *   declarations:
+         *     selector string, weight, part count, parts (direct, depth, tag, id, classes, pseudo mask)
+         *     for colors, strings, floats, ints and bools: count, then (property, value) pairs
+         */
+        const char magic[4]{'P', 'U', 'S', 'S'};
+
+        /**
+         * Writes strings as offsets in a table of interned strings
+         */
+        class Writer : public BinaryWriter {
+        public:
+            using BinaryWriter::write;
+
+            void write(const std::string &string) {
+                write(intern(string));
+            }
+
+            std::vector<uint8_t> strings{};
+
+        protected:
+            std::unordered_map<std::string, uint32_t> _offsets{};
+
+            uint32_t intern(const std::string &string) {
+                auto it = _offsets.find(string);
+                if (it != _offsets.end()) {
+                    return it->second;
+                }
+                auto offset = static_cast<uint32_t>(strings.size());
+                strings.insert(strings.end(), string.cbegin(), string.cend());
+                strings.push_back('\0');
+                _offsets[string] = offset;
+                return offset;
+            }
+        };
+
+        class Reader : public BinaryReader {
+        public:
+            Reader(const uint8_t *data, const std::size_t size) :
+                BinaryReader(data, size, "compiled stylesheet") {}
+
+            void setStrings(const uint8_t *strings, const std::size_t size) {
+                _strings     = reinterpret_cast<const char *>(strings);
+                _stringsSize = size;
+            }
+
+            std::string readString() {
+                auto offset = read<uint32_t>();
+                if (offset >= _stringsSize) {
+                    throw std::runtime_error("Compiled stylesheet has an invalid string offset");
+                }
+                auto length = strnlen(_strings + offset, _stringsSize - offset);
+                if (offset + length >= _stringsSize) {
+                    throw std::runtime_error("Compiled stylesheet has an unterminated string");
+                }
+                return std::string(_strings + offset, length);
+            }
+
+        protected:
+            const char  *_strings{nullptr};
+            std::size_t _stringsSize{0};
+        };
+
+        template<typename Map, typename Write>
+        void writeBlock(Writer &writer, const Map &values, Write writeValue) {
+            writer.write(static_cast<uint16_t>(values.size()));
+            for (const auto &kv: values) {
+                writer.write(static_cast<uint16_t>(kv.first));
+                writeValue(kv.second);
+            }
+        }
+
+        template<typename Map, typename Read>
+        void readBlock(Reader &reader, Map &values, Read readValue) {
+            auto count = reader.read<uint16_t>();
+            for (uint16_t i = 0; i < count; ++i) {
+                auto property = static_cast<typename Map::key_type>(reader.read<uint16_t>());
+                values[property] = readValue();
+            }
+        }
+    }
+
+    std::vector<uint8_t> CompiledStyleSheet::compile(const StyleManager *manager) {
+        Writer declarations{};
+
+        for (const auto &kv: manager->_declarations) {
+            const StyleDeclaration *declaration = kv.second.get();
+            declarations.write(kv.first);
+            declarations.write(static_cast<int32_t>(declaration->weight()));
+
+            uint32_t parts = 0;
+            for (auto part = declaration->selector(); part; part = part->_next.get()) {
+                ++parts;
+            }
+            declarations.write(parts);
+            for (auto part = declaration->selector(); part; part = part->_next.get()) {
+                declarations.write(static_cast<uint8_t>(part->_direct ? 1 : 0));
+                declarations.write(static_cast<int32_t>(part->_depth));
+                declarations.write(part->_tag);
+                declarations.write(part->_id);
+                declarations.write(static_cast<uint32_t>(part->_classes.size()));
+                for (const auto &className: part->_classes) {
+                    declarations.write(className);
+                }
+                uint32_t pseudo = 0;
+                for (auto p: part->_pseudo) {
+                    pseudo |= 1u << p;
+                }
+                declarations.write(pseudo);
+            }
+
+            const Style *style = declaration->style();
+            writeBlock(declarations, style->_colorValues, [&](Color value) { declarations.write(static_cast<uint32_t>(value)); });
+            writeBlock(declarations, style->_stringValues, [&](const std::string &value) { declarations.write(value); });
+            writeBlock(declarations, style->_floatValues, [&](float value) { declarations.write(value); });
+            writeBlock(declarations, style->_intValues, [&](int value) { declarations.write(static_cast<int32_t>(value)); });
+            writeBlock(declarations, style->_boolValues, [&](bool value) { declarations.write(static_cast<uint8_t>(value ? 1 : 0)); });
+        }
+
+        BinaryWriter sheet{};
+        sheet.writeHeader(magic, version);
+        sheet.write(static_cast<uint32_t>(manager->_declarations.size()));
+        sheet.write(static_cast<uint32_t>(declarations.strings.size()));
+        sheet.write(declarations.strings.data(), declarations.strings.size());
+        sheet.write(declarations.data.data(), declarations.data.size());
+        return std::move(sheet.data);
+    }
+
+    void CompiledStyleSheet::save(const StyleManager *manager, const std::string &path) {
+        BinaryWriter writer{};
+        writer.data = compile(manager);
+        writer.save(path, "compiled stylesheet");
+    }
+
+    void CompiledStyleSheet::load(StyleManager *manager, const uint8_t *data, const std::size_t size) {
+        Reader reader{data, size};
+        reader.readHeader(magic, version);
+        auto count       = reader.read<uint32_t>();
+        auto stringsSize = reader.read<uint32_t>();
+        reader.setStrings(reader.take(stringsSize), stringsSize);
+
+        manager->_declarations.reserve(manager->_declarations.size() + count);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            std::string selectorString = reader.readString();
+            auto        weight         = reader.read<int32_t>();
+
+            // Parts are stored from the selector itself to its furthest ancestor
+            std::unique_ptr<StyleSelector> selector{nullptr};
+            StyleSelector                  *last = nullptr;
+            auto                           parts = reader.read<uint32_t>();
+            for (uint32_t p = 0; p < parts; ++p) {
+                auto part = std::make_unique<StyleSelector>();
+                part->_direct = reader.read<uint8_t>() != 0;
+                part->_depth  = reader.read<int32_t>();
+                part->_tag    = reader.readString();
+                part->_id     = reader.readString();
+                auto classes = reader.read<uint32_t>();
+                part->_classes.reserve(classes);
+                for (uint32_t c = 0; c < classes; ++c) {
+                    part->_classes.push_back(reader.readString());
+                }
+                auto pseudo = reader.read<uint32_t>();
+                for (int ps = focus; ps <= lastChild; ++ps) {
+                    if (pseudo & (1u << ps)) {
+                        part->_pseudo.insert(static_cast<Pseudo>(ps));
+                    }
+                }
+
+                StyleSelector *current = part.get();
+                if (last) {
+                    last->_next = std::move(part);
+                } else {
+                    selector = std::move(part);
+                }
+                last = current;
+            }
+            if (!selector) {
+                throw std::runtime_error("Compiled stylesheet has an empty selector");
+            }
+
+            auto &declaration = manager->_declarations[selectorString];
+            if (!declaration) {
+                declaration = std::make_unique<StyleDeclaration>(
+                    std::move(selector),
+                    weight,
+                    [manager]() { manager->_valid = false; }
+                );
+                #ifdef DEBUG_STYLES
+                declaration->selectorString = selectorString;
+                #endif
+            }
+
+            // Values go straight into the maps, the manager is invalidated once at the end
+            Style *style = declaration->style();
+            readBlock(reader, style->_colorValues, [&reader]() { return static_cast<Color>(reader.read<uint32_t>()); });
+            readBlock(reader, style->_stringValues, [&reader]() { return reader.readString(); });
+            readBlock(reader, style->_floatValues, [&reader]() { return reader.read<float>(); });
+            readBlock(reader, style->_intValues, [&reader]() { return static_cast<int>(reader.read<int32_t>()); });
+            readBlock(reader, style->_boolValues, [&reader]() { return reader.read<uint8_t>() != 0; });
+        }
+
+        manager->_valid = false;
+    }
+
+    void CompiledStyleSheet::load(StyleManager *manager, const std::string &path) {
+        #ifdef PSYCHIC_UI_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Could not open compiled stylesheet \"" + path + "\"");
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            throw std::runtime_error("Could not read compiled stylesheet \"" + path + "\"");
+        }
+        auto size = static_cast<std::size_t>(info.st_size);
+        void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("Could not map compiled stylesheet \"" + path + "\"");
+        }
+        try {
+            load(manager, static_cast<const uint8_t *>(data), size);
+        } catch (...) {
+            ::munmap(data, size);
+            throw;
+        }
+        ::munmap(data, size);
+        #else
+        auto data = BinaryReader::load(path, "compiled stylesheet");
+        load(manager, data.data(), data.size());
+        #endif
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace psychic_ui {
+    class StyleManager;
+
+    /**
+     * @class CompiledStyleSheet
+     *
+     * Binary form of the style declarations of a StyleManager. Selectors are stored
+     * pre-parsed along with their weight, and each declaration's values are stored
+     * as dense property blocks, so loading is a single pass over the data instead of
+     * lowercasing and parsing every selector like `StyleManager::style` does.
+     *
+     * Only the declarations are compiled, fonts and skins are code and still have to be
+     * registered by a StyleSheet. A typical use is to compile a theme once at build time:
+     *
+     *     manager->loadStyleSheet<DefaultStyleSheet>();
+     *     CompiledStyleSheet::save(manager, "default.pss");
+     *
+     * and to load it at startup or when switching themes:
+     *
+     *     CompiledStyleSheet::load(manager, "default.pss");
+     *
+     * The format uses the native byte order, files are rejected when it doesn't match.
+     */
+    class CompiledStyleSheet {
+    public:
+        static const uint32_t version;
+
+        /**
+         * Compile the declarations of a style manager
+         * @return Compiled stylesheet data
+         */
+        static std::vector<uint8_t> compile(const StyleManager *manager);
+
+        /**
+         * Compile the declarations of a style manager to a file
+         */
+        static void save(const StyleManager *manager, const std::string &path);
+
+        /**
+         * Load compiled declarations into a style manager
+         * Declarations already in the manager get the compiled values overlaid,
+         * like they would when calling `style(selector)->set(...)`.
+         * Throws a `std::runtime_error` if the data is not a valid compiled stylesheet.
+         */
+        static void load(StyleManager *manager, const uint8_t *data, std::size_t size);
+
+        /**
+         * Load a compiled stylesheet file into a style manager
+         * The file is memory-mapped when the platform supports it.
+         */
+        static void load(StyleManager *manager, const std::string &path);
+    };
+}
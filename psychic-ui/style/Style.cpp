@@ -1,10 +1,19 @@
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include "Style.hpp"
 #include "../Div.hpp"
+#include "../utils/Pool.hpp"
 
 namespace psychic_ui {
 
+    const int Cursor::Arrow;
+    const int Cursor::IBeam;
+    const int Cursor::Crosshair;
+    const int Cursor::Hand;
+    const int Cursor::HResize;
+    const int Cursor::VResize;
+
     std::unique_ptr<Style> Style::dummyStyle{std::make_unique<Style>()};
     const float Style::Auto = nanf("auto");
 
@@ -15,6 +24,23 @@ namespace psychic_ui {
     Style::Style(const std::function<void()> &onChanged) :
         _onChanged(onChanged) {}
 
+    #ifdef PSYCHIC_UI_POOL_ALLOCATION
+    void *Style::operator new(const std::size_t size) {
+        if (size != sizeof(Style)) {
+            return ::operator new(size);
+        }
+        return poolFor<Style>().allocate();
+    }
+
+    void Style::operator delete(void *style, const std::size_t size) {
+        if (size != sizeof(Style)) {
+            ::operator delete(style);
+            return;
+        }
+        poolFor<Style>().deallocate(style);
+    }
+    #endif
+
     Style *Style::overlay(const Style *style) {
         if (style) {
             doOverlay(style->_colorValues, _colorValues);
@@ -66,6 +92,65 @@ namespace psychic_ui {
         return this;
     }
 
+    Style *Style::remove(const Style *style) {
+        if (style) {
+            doRemove(style->_colorValues, _colorValues);
+            doRemove(style->_stringValues, _stringValues);
+            doRemove(style->_floatValues, _floatValues);
+            doRemove(style->_intValues, _intValues);
+            doRemove(style->_boolValues, _boolValues);
+
+            // Just assume something changed
+            if (_onChanged) {
+                _onChanged();
+            }
+        }
+
+        return this;
+    }
+
+    Style *Style::pick(const Style *from, const Style *properties) {
+        if (from && properties) {
+            doPick(from->_colorValues, properties->_colorValues, _colorValues);
+            doPick(from->_stringValues, properties->_stringValues, _stringValues);
+            doPick(from->_floatValues, properties->_floatValues, _floatValues);
+            doPick(from->_intValues, properties->_intValues, _intValues);
+            doPick(from->_boolValues, properties->_boolValues, _boolValues);
+
+            // Just assume something changed
+            if (_onChanged) {
+                _onChanged();
+            }
+        }
+
+        return this;
+    }
+
+    Style *Style::common(const Style *a, const Style *b) {
+        if (a && b) {
+            doCommon(a->_colorValues, b->_colorValues, _colorValues);
+            doCommon(a->_stringValues, b->_stringValues, _stringValues);
+            doCommon(a->_floatValues, b->_floatValues, _floatValues);
+            doCommon(a->_intValues, b->_intValues, _intValues);
+            doCommon(a->_boolValues, b->_boolValues, _boolValues);
+
+            // Just assume something changed
+            if (_onChanged) {
+                _onChanged();
+            }
+        }
+
+        return this;
+    }
+
+    bool Style::empty() const {
+        return _colorValues.empty()
+               && _stringValues.empty()
+               && _floatValues.empty()
+               && _intValues.empty()
+               && _boolValues.empty();
+    }
+
     void Style::trace() const {
         #ifdef DEBUG_STYLES
         for (const auto &declaration: declarations) {
@@ -96,10 +181,27 @@ namespace psychic_ui {
         std::cout << "}" << std::endl << std::endl;
     }
 
+    namespace {
+        template<typename Map>
+        bool floatValuesEqual(const Map &a, const Map &b) {
+            if (a.size() != b.size()) {
+                return false;
+            }
+            for (const auto &kv: a) {
+                auto other = b.find(kv.first);
+                // Auto is NaN, it still has to compare equal to itself
+                if (other == b.cend() || !(kv.second == other->second || (std::isnan(kv.second) && std::isnan(other->second)))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
     bool Style::operator==(const Style &other) const {
         return _colorValues == other._colorValues
                && _stringValues == other._stringValues
-               && _floatValues == other._floatValues
+               && floatValuesEqual(_floatValues, other._floatValues)
                && _intValues == other._intValues
                && _boolValues == other._boolValues;
     }
@@ -85,7 +85,8 @@ namespace psychic_ui {
             flexWrap, overflow,
         // Custom
             skin,
-            orientation // For sliders
+            orientation, // For sliders
+            transition // See Transition
     };
 
     enum FloatProperty {
@@ -112,6 +113,8 @@ namespace psychic_ui {
             fontSize, letterSpacing, lineHeight,
             borderRadius, borderRadiusTop, borderRadiusBottom, borderRadiusLeft, borderRadiusRight,
             borderRadiusTopLeft, borderRadiusTopRight, borderRadiusBottomLeft, borderRadiusBottomRight,
+        // Compositing, around the center of the div, rotation in degrees
+            translateX, translateY, scale, scaleX, scaleY, rotate,
     };
 
     enum IntProperty {
@@ -124,7 +127,9 @@ namespace psychic_ui {
         // Custom
             antiAlias,
             textAntiAlias,
-            visible
+            visible,
+            renderCache,
+            scrollLayer
     };
 
     struct InheritableValues {
@@ -149,6 +154,8 @@ namespace psychic_ui {
     };
 
     class Style {
+        friend class CompiledStyleSheet;
+
     public:
         /**
          * Dummy style is used when we don't want to disrupt the styling code by having to
@@ -163,6 +170,15 @@ namespace psychic_ui {
         explicit Style(const Style *fromStyle);
         explicit Style(const std::function<void()> &onChanged);
 
+        #ifdef PSYCHIC_UI_POOL_ALLOCATION
+        /**
+         * Every div owns three styles, they are drawn from a pool to avoid
+         * going through malloc/free when building and tearing down trees.
+         */
+        static void *operator new(std::size_t size);
+        static void operator delete(void *style, std::size_t size);
+        #endif
+
         /**
          * Add all values from style onto this
          * @param style
@@ -181,6 +197,31 @@ namespace psychic_ui {
          */
         Style *defaults(const Style *style);
 
+        /**
+         * Remove the properties that are set in style from this, whatever their value
+         * @param style
+         */
+        Style *remove(const Style *style);
+
+        /**
+         * Add the values of from for the properties that are set in properties
+         * @param from
+         * @param properties
+         */
+        Style *pick(const Style *from, const Style *properties);
+
+        /**
+         * Add the values set to the same value in both styles
+         * @param a
+         * @param b
+         */
+        Style *common(const Style *a, const Style *b);
+
+        /**
+         * Whether no property is set
+         */
+        bool empty() const;
+
         bool operator==(const Style &other) const;
         bool operator!=(const Style &other) const;
 
@@ -205,6 +246,43 @@ namespace psychic_ui {
             }
         }
 
+        template<class T>
+        inline static void doRemove(const T &from, T &onto) {
+            for (auto const &kv : from) {
+                onto.erase(kv.first);
+            }
+        }
+
+        template<class T>
+        inline static void doPick(const T &from, const T &properties, T &onto) {
+            for (auto const &kv : properties) {
+                auto search = from.find(kv.first);
+                if (search != from.cend()) {
+                    onto[kv.first] = search->second;
+                }
+            }
+        }
+
+        template<typename V>
+        inline static bool sameValue(const V &a, const V &b) {
+            return a == b;
+        }
+
+        inline static bool sameValue(const float a, const float b) {
+            // Auto and undefined are both NaN
+            return a == b || (std::isnan(a) && std::isnan(b));
+        }
+
+        template<class T>
+        inline static void doCommon(const T &a, const T &b, T &onto) {
+            for (auto const &kv : a) {
+                auto search = b.find(kv.first);
+                if (search != b.cend() && sameValue(kv.second, search->second)) {
+                    onto[kv.first] = kv.second;
+                }
+            }
+        }
+
         template<class T>
         inline static void doDefaults(const T &from, T &onto) {
             for (auto const &kv : from) {
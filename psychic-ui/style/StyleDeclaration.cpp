@@ -12,6 +12,11 @@ namespace psychic_ui {
         _weight = _selector->weight();
     }
 
+    StyleDeclaration::StyleDeclaration(std::unique_ptr<StyleSelector> selector, const int weight, const std::function<void()> &onChanged) :
+        _selector(std::move(selector)),
+        _style(std::make_unique<Style>(onChanged)),
+        _weight(weight) {}
+
     const StyleSelector *StyleDeclaration::selector() const {
         return _selector.get();
     }
@@ -12,6 +12,11 @@ namespace psychic_ui {
     public:
         explicit StyleDeclaration(std::unique_ptr<StyleSelector> selector);
         StyleDeclaration(std::unique_ptr<StyleSelector> selector, const std::function<void()> &onChanged);
+
+        /**
+         * Create a declaration with a precomputed weight, used when loading compiled stylesheets
+         */
+        StyleDeclaration(std::unique_ptr<StyleSelector> selector, int weight, const std::function<void()> &onChanged);
         const StyleSelector *selector() const;
         Style *style() const;
 
@@ -1,12 +1,52 @@
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
 #include "StyleManager.hpp"
 #include "../Div.hpp"
+#include "../Skin.hpp"
 #include "../utils/StringUtils.hpp"
+#include "../utils/Log.hpp"
 
 namespace psychic_ui {
 
     std::shared_ptr<StyleManager> StyleManager::instance{nullptr};
 
+    namespace {
+        int64_t modificationTime(const struct stat &info) {
+            #if defined(__APPLE__)
+            const struct timespec &time = info.st_mtimespec;
+            #else
+            const struct timespec &time = info.st_mtim;
+            #endif
+            // Whole seconds would miss edits made within the same second
+            return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+        }
+
+        bool readStyleSheet(const std::string &path, std::string &source, int64_t &modified, std::size_t &size) {
+            struct stat info{};
+            if (stat(path.c_str(), &info) != 0) {
+                return false;
+            }
+            std::ifstream file(path);
+            if (!file) {
+                return false;
+            }
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            source   = buffer.str();
+            modified = modificationTime(info);
+            size     = static_cast<std::size_t>(info.st_size);
+            return true;
+        }
+
+        void logStyleSheetErrors(const std::string &path, const std::vector<StyleParser::Error> &errors) {
+            for (const auto &error: errors) {
+                PSYCHIC_LOG_WARNING(path << ":" << error.line << ": " << error.message);
+            }
+        }
+    }
+
     std::shared_ptr<StyleManager> StyleManager::getInstance() {
         if (!instance) {
             instance = std::make_shared<StyleManager>();
@@ -17,7 +57,10 @@ namespace psychic_ui {
     void StyleManager::reset() {
         _fonts.clear();
         _skins.clear();
+        _skinRenderers.clear();
         _declarations.clear();
+        _watchedStyleSheets.clear();
+        _changedSelectors.clear();
         _valid = false;
     }
     
@@ -32,15 +75,41 @@ namespace psychic_ui {
         return font != _fonts.cend() ? font->second : nullptr;
     }
 
-    StyleManager *StyleManager::registerSkin(const std::string &name, SkinMaker hatcher) {
-        _skins.insert(std::make_pair(name, std::move(hatcher)));
+    StyleManager *StyleManager::registerSkin(const std::string &name, SkinMaker hatcher, const std::size_t poolSize) {
+        _skins.insert(std::make_pair(name, SkinRegistration{std::move(hatcher), poolSize > 0 ? std::make_shared<SkinPool>(poolSize) : nullptr}));
         _valid = false;
         return this;
     }
 
     std::shared_ptr<internal::SkinBase> StyleManager::skin(const std::string &name) {
+        // Windows producing their frames in parallel hatch skins concurrently
+        std::lock_guard<std::mutex> lock(_skinMutex);
+        auto                        skin = _skins.find(name);
+        if (skin == _skins.cend()) {
+            return nullptr;
+        }
+        if (skin->second.pool) {
+            if (auto pooled = skin->second.pool->acquire()) {
+                return pooled;
+            }
+        }
+        return skin->second.hatcher->hatch();
+    }
+
+    std::shared_ptr<SkinPool> StyleManager::skinPool(const std::string &name) const {
         auto skin = _skins.find(name);
-        return skin != _skins.cend() ? skin->second->hatch() : nullptr;
+        return skin != _skins.cend() ? skin->second.pool : nullptr;
+    }
+
+    StyleManager *StyleManager::registerSkinRenderer(const std::string &name, std::shared_ptr<internal::SkinRendererBase> renderer) {
+        _skinRenderers[name] = std::move(renderer);
+        _valid = false;
+        return this;
+    }
+
+    std::shared_ptr<internal::SkinRendererBase> StyleManager::skinRenderer(const std::string &name) const {
+        auto renderer = _skinRenderers.find(name);
+        return renderer != _skinRenderers.cend() ? renderer->second : nullptr;
     }
 
     Style *StyleManager::style(std::string selectorString) {
@@ -51,7 +120,7 @@ namespace psychic_ui {
         } else {
             auto selector = StyleSelector::fromSelector(selectorString);
             if (!selector) {
-                std::cerr << "Invalid selector: \"" << selectorString << "\", returning dummy style.";
+                PSYCHIC_LOG_WARNING("Invalid selector: \"" << selectorString << "\", returning dummy style.");
                 return Style::dummyStyle.get();
             }
 
@@ -68,6 +137,188 @@ namespace psychic_ui {
         }
     }
 
+    std::shared_ptr<StyleManager> StyleManager::snapshot() const {
+        auto copy = std::make_shared<StyleManager>();
+        copy->_declarations.reserve(_declarations.size());
+        for (const auto &kv: _declarations) {
+            copy->style(kv.first)->overlay(kv.second->style());
+        }
+        copy->_fonts         = _fonts;
+        copy->_skins         = _skins;
+        copy->_skinRenderers = _skinRenderers;
+        copy->_valid         = true;
+        return copy;
+    }
+
+    bool StyleManager::loadStyleSheetFile(const std::string &path, const bool watch) {
+        WatchedStyleSheet sheet{};
+        std::string       source{};
+        if (!readStyleSheet(path, source, sheet.modified, sheet.size)) {
+            PSYCHIC_LOG_WARNING("Could not read stylesheet \"" << path << "\"");
+            return false;
+        }
+
+        std::vector<StyleParser::Error> errors{};
+        auto                            declarations = StyleParser::parse(source, &errors);
+        logStyleSheetErrors(path, errors);
+
+        if (watch) {
+            // Applied like a reload from an empty sheet, to know which values it replaced
+            sheet.path = path;
+            applyStyleSheet(sheet, std::move(declarations));
+            _changedSelectors.clear();
+            _watchedStyleSheets.push_back(std::move(sheet));
+        } else {
+            for (const auto &declaration: declarations) {
+                style(declaration.first)->overlay(declaration.second.get());
+            }
+        }
+        _valid = false;
+        return true;
+    }
+
+    bool StyleManager::reloadStyleSheets(const bool force) {
+        if (_inFrame || _watchedStyleSheets.empty()) {
+            return false;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (!force && now - _lastStyleSheetCheck < std::chrono::milliseconds(250)) {
+            return false;
+        }
+        _lastStyleSheetCheck = now;
+
+        bool changed = false;
+        for (auto &sheet: _watchedStyleSheets) {
+            struct stat info{};
+            if (stat(sheet.path.c_str(), &info) != 0
+                || (modificationTime(info) == sheet.modified && static_cast<std::size_t>(info.st_size) == sheet.size)) {
+                continue;
+            }
+
+            std::string source{};
+            if (!readStyleSheet(sheet.path, source, sheet.modified, sheet.size)) {
+                continue;
+            }
+
+            std::vector<StyleParser::Error> errors{};
+            auto                            declarations = StyleParser::parse(source, &errors);
+            logStyleSheetErrors(sheet.path, errors);
+
+            if (!changed) {
+                _changedSelectors.clear();
+                changed = true;
+            }
+            applyStyleSheet(sheet, std::move(declarations));
+            PSYCHIC_LOG_INFO("Reloaded stylesheet \"" << sheet.path << "\"");
+        }
+
+        if (changed) {
+            ++_styleSheetRevision;
+        }
+        return changed;
+    }
+
+    void StyleManager::applyStyleSheet(WatchedStyleSheet &sheet, StyleParser::Declarations declarations) {
+        // Applying the changes would invalidate the whole manager, the changed selectors are used instead
+        bool wasValid = _valid;
+
+        StyleParser::Declarations shadowed{};
+
+        auto apply = [this, &sheet, &shadowed](const std::string &selector, const Style *before, const Style *after) {
+            auto        previousShadow = sheet.shadowed.find(selector);
+            const Style *shadow        = previousShadow != sheet.shadowed.cend() ? previousShadow->second.get() : nullptr;
+
+            if (before && after && *before == *after) {
+                if (shadow) {
+                    shadowed[selector] = std::make_unique<Style>(shadow);
+                }
+                return;
+            }
+            Style *declaration = style(selector);
+            if (declaration == Style::dummyStyle.get()) {
+                return;
+            }
+
+            // Values the sheet set that nothing replaced since then go back to what they shadowed,
+            // the others were set by code or by another sheet and are left alone
+            Style owned{};
+            owned.common(before, declaration);
+            Style replaced{before};
+            replaced.remove(&owned);
+            Style restored{};
+            restored.pick(shadow, &owned);
+            declaration->remove(&owned)->overlay(&restored);
+
+            Style applied{after};
+            applied.remove(&replaced);
+            Style stillReplaced{};
+            stillReplaced.pick(&replaced, after);
+            auto nextShadow = std::make_unique<Style>();
+            nextShadow->pick(shadow, &stillReplaced)->pick(declaration, &applied);
+            declaration->overlay(&applied);
+
+            if (!nextShadow->empty()) {
+                shadowed[selector] = std::move(nextShadow);
+            }
+            if (declaration->empty()) {
+                _declarations.erase(selector);
+            }
+            if (auto changedSelector = StyleSelector::fromSelector(selector)) {
+                _changedSelectors.push_back(std::move(changedSelector));
+            }
+        };
+
+        for (const auto &declaration: sheet.declarations) {
+            auto next = declarations.find(declaration.first);
+            apply(declaration.first, declaration.second.get(), next != declarations.cend() ? next->second.get() : nullptr);
+        }
+        for (const auto &declaration: declarations) {
+            if (sheet.declarations.find(declaration.first) == sheet.declarations.cend()) {
+                apply(declaration.first, nullptr, declaration.second.get());
+            }
+        }
+
+        sheet.declarations = std::move(declarations);
+        sheet.shadowed     = std::move(shadowed);
+        _valid = wasValid;
+    }
+
+    void StyleManager::invalidateChanged(Div *root) const {
+        if (root && !_changedSelectors.empty()) {
+            invalidateMatching(root);
+        }
+    }
+
+    void StyleManager::invalidateMatching(Div *div) const {
+        // Dirty divs already have their whole subtree invalidated
+        if (div->_styleDirty) {
+            return;
+        }
+        for (const auto &selector: _changedSelectors) {
+            if (selector->matches(div)) {
+                div->invalidateStyle();
+                return;
+            }
+        }
+        for (const auto &child: div->_children) {
+            invalidateMatching(child.get());
+        }
+    }
+
+    void StyleManager::beginFrame() {
+        reloadStyleSheets();
+        // `computeStyle` creates the global declaration on first use, it can't during the frame
+        style("*");
+        _frameValid = _valid;
+        _inFrame    = true;
+    }
+
+    void StyleManager::endFrame() {
+        _inFrame = false;
+        _valid   = true;
+    }
+
     std::unique_ptr<Style> StyleManager::computeStyle(const Div *component) {
         std::vector<std::pair<int, StyleDeclaration *>> directMatches;
 
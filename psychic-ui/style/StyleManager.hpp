@@ -3,6 +3,9 @@
 #include <unordered_map>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <chrono>
+#include <vector>
 #include <functional>
 #include <type_traits>
 #include "psychic-ui/psychic-ui.hpp"
@@ -10,19 +13,26 @@
 #include "Style.hpp"
 #include "StyleSelector.hpp"
 #include "StyleSheet.hpp"
+#include "CompiledStyleSheet.hpp"
+#include "StyleParser.hpp"
 #include "StyleDeclaration.hpp"
 
 namespace psychic_ui {
     class Div;
 
+    class SkinPool;
+
     namespace internal {
         class SkinBase;
+        class SkinRendererBase;
     }
 
     using SkinType = Hatcher<std::shared_ptr<internal::SkinBase>>;
     using SkinMaker = std::shared_ptr<SkinType>;
 
     class StyleManager {
+        friend class CompiledStyleSheet;
+
     public:
         static std::shared_ptr<StyleManager> instance;
         static std::shared_ptr<StyleManager> getInstance();
@@ -41,23 +51,146 @@ namespace psychic_ui {
             _valid = false;
         }
 
-        bool valid() const { return _valid; };
+        /**
+         * Load a stylesheet compiled with `CompiledStyleSheet`
+         * Much faster than running the equivalent StyleSheet since no selector has to be parsed.
+         */
+        void loadCompiledStyleSheet(const std::string &path, bool reset = false) {
+            if (reset) {
+                this->reset();
+            }
+            CompiledStyleSheet::load(this, path);
+        }
+
+        /**
+         * Load a text stylesheet, see StyleParser for the syntax
+         * Parse errors are logged, the valid rules are still loaded.
+         * @param path Stylesheet file
+         * @param watch Reload the stylesheet when the file changes
+         * @return Whether the file could be read
+         */
+        bool loadStyleSheetFile(const std::string &path, bool watch = false);
+
+        /**
+         * Reload the watched stylesheets that changed on disk
+         * Called by the windows every frame, the files are only checked a few times per second.
+         * Only the declarations that changed are updated, and instead of invalidating the whole
+         * manager, their selectors are kept in `changedSelectors()` for the windows to restyle
+         * only the divs they match.
+         * @param force Check the files even if they were checked recently
+         * @return Whether something changed
+         */
+        bool reloadStyleSheets(bool force = false);
+
+        /**
+         * Whether stylesheets are watched, idle main loops then still wake up to check them
+         */
+        bool watchingStyleSheets() const { return !_watchedStyleSheets.empty(); }
+
+        /**
+         * Incremented every time watched stylesheets are reloaded with changes
+         */
+        uint64_t styleSheetRevision() const { return _styleSheetRevision; }
+
+        /**
+         * Selectors of the declarations changed by the last reload
+         */
+        const std::vector<std::unique_ptr<StyleSelector>> &changedSelectors() const { return _changedSelectors; }
+
+        /**
+         * Invalidate the style of the divs matching the selectors changed by the last reload
+         * @param root Root of the tree to invalidate
+         */
+        void invalidateChanged(Div *root) const;
+
+        bool valid() const { return _inFrame ? _frameValid : _valid; };
+
+        void setValid() {
+            if (!_inFrame) {
+                _valid = true;
+            }
+        }
+
+        /**
+         * Start a frame produced by several windows in parallel
+         * Reloads the watched stylesheets, after that the manager is read-only until `endFrame()`:
+         * `valid()` keeps its value and `setValid()` does nothing, so that every window sharing
+         * the manager sees the same state. Declarations, fonts and skins must not be registered
+         * or modified during the frame, only `computeStyle()` and `skin()` can be called from the
+         * window threads.
+         */
+        void beginFrame();
+
+        /**
+         * End the parallel frame, the styles are valid again
+         */
+        void endFrame();
 
-        void setValid() { _valid = true; }
+        bool inFrame() const { return _inFrame; }
 
         StyleManager *loadFont(const std::string &name, const std::string &path);
         const sk_sp<SkTypeface> font(const std::string &name) const;
 
-        StyleManager *registerSkin(const std::string &name, SkinMaker hatcher);
+        /**
+         * Register a skin
+         * @param name Skin name, as used by the `skin` style property
+         * @param hatcher Skin maker
+         * @param poolSize Number of skins released by components to keep for reuse, 0 to disable pooling
+         */
+        StyleManager *registerSkin(const std::string &name, SkinMaker hatcher, std::size_t poolSize = 0);
         std::shared_ptr<internal::SkinBase> skin(const std::string &name);
+        std::shared_ptr<SkinPool> skinPool(const std::string &name) const;
+
+        /**
+         * Register a flyweight skin, shared by all the components using it
+         * Renderers take precedence over skins registered with the same name.
+         */
+        StyleManager *registerSkinRenderer(const std::string &name, std::shared_ptr<internal::SkinRendererBase> renderer);
+        std::shared_ptr<internal::SkinRendererBase> skinRenderer(const std::string &name) const;
 
         Style *style(std::string selector);
         std::unique_ptr<Style> computeStyle(const Div *component);
 
+        /**
+         * Copy the declarations, fonts and skins into a new manager
+         * Lets another thread compute styles while this manager keeps changing. Skin pools
+         * and renderers are shared, stylesheets are not watched by the copy.
+         */
+        std::shared_ptr<StyleManager> snapshot() const;
+
     protected:
-        std::unordered_map<std::string, std::unique_ptr<StyleDeclaration>> _declarations{};
-        std::unordered_map<std::string, sk_sp<SkTypeface>>                 _fonts{};
-        std::unordered_map<std::string, SkinMaker>                         _skins{};
-        bool                                                               _valid{false};
+        struct SkinRegistration {
+            SkinMaker                 hatcher{nullptr};
+            std::shared_ptr<SkinPool> pool{nullptr};
+        };
+
+        std::unordered_map<std::string, std::unique_ptr<StyleDeclaration>>           _declarations{};
+        std::unordered_map<std::string, sk_sp<SkTypeface>>                           _fonts{};
+        std::unordered_map<std::string, SkinRegistration>                            _skins{};
+        std::unordered_map<std::string, std::shared_ptr<internal::SkinRendererBase>> _skinRenderers{};
+        bool                                                                         _valid{false};
+        bool                                                                         _inFrame{false};
+        bool                                                                         _frameValid{false};
+        std::mutex                                                                   _skinMutex{};
+
+        struct WatchedStyleSheet {
+            std::string               path{};
+            int64_t                   modified{0}; // Nanoseconds
+            std::size_t               size{0};
+            StyleParser::Declarations declarations{};
+            /**
+             * Values the sheet's declarations replaced, from code or from previously loaded
+             * sheets, restored when the sheet stops setting them
+             */
+            StyleParser::Declarations shadowed{};
+        };
+
+        std::vector<WatchedStyleSheet>              _watchedStyleSheets{};
+        std::chrono::steady_clock::time_point       _lastStyleSheetCheck{};
+        uint64_t                                    _styleSheetRevision{0};
+        std::vector<std::unique_ptr<StyleSelector>> _changedSelectors{};
+
+        void applyStyleSheet(WatchedStyleSheet &sheet, StyleParser::Declarations declarations);
+        void invalidateMatching(Div *div) const;
     };
 }
@@ -0,0 +1,562 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <unordered_map>
+#include "StyleParser.hpp"
+#include "../utils/StringUtils.hpp"
+
+namespace psychic_ui {
+
+    namespace {
+
+        enum class PropertyType {
+            Color,
+            String,
+            Float,
+            Int,
+            Bool
+        };
+
+        struct PropertyInfo {
+            PropertyType type;
+            int          property;
+        };
+
+        std::string propertyKey(const std::string &name) {
+            std::string key{};
+            key.reserve(name.size());
+            for (char c: name) {
+                if (c != '-' && c != '_') {
+                    key += static_cast<char>(::tolower(c));
+                }
+            }
+            return key;
+        }
+
+        #define PSYCHIC_PROPERTY(type, name) {propertyKey(#name), {PropertyType::type, static_cast<int>(name)}}
+
+        const std::unordered_map<std::string, PropertyInfo> &properties() {
+            static const std::unordered_map<std::string, PropertyInfo> table{
+                PSYCHIC_PROPERTY(Color, color),
+                PSYCHIC_PROPERTY(Color, backgroundColor),
+                PSYCHIC_PROPERTY(Color, borderColor),
+                PSYCHIC_PROPERTY(Color, borderHorizontalColor),
+                PSYCHIC_PROPERTY(Color, borderLeftColor),
+                PSYCHIC_PROPERTY(Color, borderRightColor),
+                PSYCHIC_PROPERTY(Color, borderVerticalColor),
+                PSYCHIC_PROPERTY(Color, borderTopColor),
+                PSYCHIC_PROPERTY(Color, borderBottomColor),
+                PSYCHIC_PROPERTY(Color, selectionColor),
+                PSYCHIC_PROPERTY(Color, selectionBackgroundColor),
+                PSYCHIC_PROPERTY(Color, contentBackgroundColor),
+
+                PSYCHIC_PROPERTY(String, fontFamily),
+                PSYCHIC_PROPERTY(String, textAlign),
+                PSYCHIC_PROPERTY(String, textJustify),
+                PSYCHIC_PROPERTY(String, position),
+                PSYCHIC_PROPERTY(String, direction),
+                PSYCHIC_PROPERTY(String, display),
+                PSYCHIC_PROPERTY(String, justifyContent),
+                PSYCHIC_PROPERTY(String, flexDirection),
+                PSYCHIC_PROPERTY(String, alignContent),
+                PSYCHIC_PROPERTY(String, alignItems),
+                PSYCHIC_PROPERTY(String, alignSelf),
+                PSYCHIC_PROPERTY(String, flexWrap),
+                PSYCHIC_PROPERTY(String, overflow),
+                PSYCHIC_PROPERTY(String, skin),
+                PSYCHIC_PROPERTY(String, orientation),
+                PSYCHIC_PROPERTY(String, transition),
+
+                PSYCHIC_PROPERTY(Float, flex),
+                PSYCHIC_PROPERTY(Float, grow),
+                PSYCHIC_PROPERTY(Float, shrink),
+                PSYCHIC_PROPERTY(Float, basis),
+                PSYCHIC_PROPERTY(Float, basisPercent),
+                PSYCHIC_PROPERTY(Float, left),
+                PSYCHIC_PROPERTY(Float, leftPercent),
+                PSYCHIC_PROPERTY(Float, right),
+                PSYCHIC_PROPERTY(Float, rightPercent),
+                PSYCHIC_PROPERTY(Float, top),
+                PSYCHIC_PROPERTY(Float, topPercent),
+                PSYCHIC_PROPERTY(Float, bottom),
+                PSYCHIC_PROPERTY(Float, bottomPercent),
+                PSYCHIC_PROPERTY(Float, width),
+                PSYCHIC_PROPERTY(Float, widthPercent),
+                PSYCHIC_PROPERTY(Float, minWidth),
+                PSYCHIC_PROPERTY(Float, minWidthPercent),
+                PSYCHIC_PROPERTY(Float, maxWidth),
+                PSYCHIC_PROPERTY(Float, maxWidthPercent),
+                PSYCHIC_PROPERTY(Float, height),
+                PSYCHIC_PROPERTY(Float, heightPercent),
+                PSYCHIC_PROPERTY(Float, minHeight),
+                PSYCHIC_PROPERTY(Float, minHeightPercent),
+                PSYCHIC_PROPERTY(Float, maxHeight),
+                PSYCHIC_PROPERTY(Float, maxHeightPercent),
+                PSYCHIC_PROPERTY(Float, margin),
+                PSYCHIC_PROPERTY(Float, marginHorizontal),
+                PSYCHIC_PROPERTY(Float, marginLeft),
+                PSYCHIC_PROPERTY(Float, marginRight),
+                PSYCHIC_PROPERTY(Float, marginVertical),
+                PSYCHIC_PROPERTY(Float, marginTop),
+                PSYCHIC_PROPERTY(Float, marginBottom),
+                PSYCHIC_PROPERTY(Float, marginPercent),
+                PSYCHIC_PROPERTY(Float, marginHorizontalPercent),
+                PSYCHIC_PROPERTY(Float, marginLeftPercent),
+                PSYCHIC_PROPERTY(Float, marginRightPercent),
+                PSYCHIC_PROPERTY(Float, marginVerticalPercent),
+                PSYCHIC_PROPERTY(Float, marginTopPercent),
+                PSYCHIC_PROPERTY(Float, marginBottomPercent),
+                PSYCHIC_PROPERTY(Float, padding),
+                PSYCHIC_PROPERTY(Float, paddingHorizontal),
+                PSYCHIC_PROPERTY(Float, paddingLeft),
+                PSYCHIC_PROPERTY(Float, paddingRight),
+                PSYCHIC_PROPERTY(Float, paddingVertical),
+                PSYCHIC_PROPERTY(Float, paddingTop),
+                PSYCHIC_PROPERTY(Float, paddingBottom),
+                PSYCHIC_PROPERTY(Float, paddingPercent),
+                PSYCHIC_PROPERTY(Float, paddingHorizontalPercent),
+                PSYCHIC_PROPERTY(Float, paddingLeftPercent),
+                PSYCHIC_PROPERTY(Float, paddingRightPercent),
+                PSYCHIC_PROPERTY(Float, paddingVerticalPercent),
+                PSYCHIC_PROPERTY(Float, paddingTopPercent),
+                PSYCHIC_PROPERTY(Float, paddingBottomPercent),
+                PSYCHIC_PROPERTY(Float, border),
+                PSYCHIC_PROPERTY(Float, borderHorizontal),
+                PSYCHIC_PROPERTY(Float, borderLeft),
+                PSYCHIC_PROPERTY(Float, borderRight),
+                PSYCHIC_PROPERTY(Float, borderVertical),
+                PSYCHIC_PROPERTY(Float, borderTop),
+                PSYCHIC_PROPERTY(Float, borderBottom),
+                PSYCHIC_PROPERTY(Float, opacity),
+                PSYCHIC_PROPERTY(Float, fontSize),
+                PSYCHIC_PROPERTY(Float, letterSpacing),
+                PSYCHIC_PROPERTY(Float, lineHeight),
+                PSYCHIC_PROPERTY(Float, borderRadius),
+                PSYCHIC_PROPERTY(Float, borderRadiusTop),
+                PSYCHIC_PROPERTY(Float, borderRadiusBottom),
+                PSYCHIC_PROPERTY(Float, borderRadiusLeft),
+                PSYCHIC_PROPERTY(Float, borderRadiusRight),
+                PSYCHIC_PROPERTY(Float, borderRadiusTopLeft),
+                PSYCHIC_PROPERTY(Float, borderRadiusTopRight),
+                PSYCHIC_PROPERTY(Float, borderRadiusBottomLeft),
+                PSYCHIC_PROPERTY(Float, borderRadiusBottomRight),
+                PSYCHIC_PROPERTY(Float, translateX),
+                PSYCHIC_PROPERTY(Float, translateY),
+                PSYCHIC_PROPERTY(Float, scale),
+                PSYCHIC_PROPERTY(Float, scaleX),
+                PSYCHIC_PROPERTY(Float, scaleY),
+                PSYCHIC_PROPERTY(Float, rotate),
+
+                PSYCHIC_PROPERTY(Int, cursor),
+                PSYCHIC_PROPERTY(Int, gap),
+
+                PSYCHIC_PROPERTY(Bool, antiAlias),
+                PSYCHIC_PROPERTY(Bool, textAntiAlias),
+                PSYCHIC_PROPERTY(Bool, visible),
+                PSYCHIC_PROPERTY(Bool, renderCache),
+                PSYCHIC_PROPERTY(Bool, scrollLayer)
+            };
+            return table;
+        }
+
+        #undef PSYCHIC_PROPERTY
+
+        std::string lowercase(std::string string) {
+            std::transform(string.begin(), string.end(), string.begin(), ::tolower);
+            return string;
+        }
+
+        bool parseNumber(const std::string &value, float &number) {
+            if (value.empty()) {
+                return false;
+            }
+            char *end = nullptr;
+            number = std::strtof(value.c_str(), &end);
+            return end == value.c_str() + value.size();
+        }
+
+        bool parseComponents(const std::string &value, std::vector<float> &components) {
+            for (const auto &part: string_utils::split(value, ',')) {
+                float component;
+                if (!parseNumber(string_utils::trim_copy(part), component)) {
+                    return false;
+                }
+                components.push_back(component);
+            }
+            return true;
+        }
+
+        unsigned int channel(float value) {
+            return static_cast<unsigned int>(std::max(0.0f, std::min(255.0f, value)));
+        }
+
+        bool parseColor(const std::string &value, Color &color) {
+            std::string v = lowercase(value);
+            if (v == "transparent") {
+                color = 0x00000000;
+                return true;
+            }
+
+            std::string hex{};
+            if (v.size() > 1 && v[0] == '#') {
+                hex = v.substr(1);
+            } else if (v.size() > 2 && v[0] == '0' && v[1] == 'x') {
+                hex = v.substr(2);
+            }
+            if (!hex.empty()) {
+                if (!std::all_of(hex.cbegin(), hex.cend(), ::isxdigit)) {
+                    return false;
+                }
+                auto parsed = static_cast<Color>(std::strtoul(hex.c_str(), nullptr, 16));
+                switch (hex.size()) {
+                    case 3: {
+                        Color r = (parsed >> 8) & 0xF;
+                        Color g = (parsed >> 4) & 0xF;
+                        Color b = parsed & 0xF;
+                        color = 0xFF000000 | (r * 0x11) << 16 | (g * 0x11) << 8 | (b * 0x11);
+                        return true;
+                    }
+                    case 6:
+                        color = 0xFF000000 | parsed;
+                        return true;
+                    case 8:
+                        color = parsed;
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+
+            bool alpha = v.compare(0, 5, "rgba(") == 0;
+            if ((alpha || v.compare(0, 4, "rgb(") == 0) && v.back() == ')') {
+                auto open = v.find('(');
+                std::vector<float> components{};
+                if (!parseComponents(v.substr(open + 1, v.size() - open - 2), components)
+                    || components.size() != (alpha ? 4u : 3u)) {
+                    return false;
+                }
+                unsigned int a = alpha ? channel(components[3] * 255.0f) : 0xFF;
+                color = SkColorSetARGB(a, channel(components[0]), channel(components[1]), channel(components[2]));
+                return true;
+            }
+
+            return false;
+        }
+
+        bool parseInt(const std::string &value, int &number) {
+            static const std::unordered_map<std::string, int> cursors{
+                {"arrow",     Cursor::Arrow},
+                {"ibeam",     Cursor::IBeam},
+                {"crosshair", Cursor::Crosshair},
+                {"hand",      Cursor::Hand},
+                {"hresize",   Cursor::HResize},
+                {"vresize",   Cursor::VResize}
+            };
+            auto cursor = cursors.find(propertyKey(value));
+            if (cursor != cursors.cend()) {
+                number = cursor->second;
+                return true;
+            }
+            float parsed;
+            if (!parseNumber(value, parsed)) {
+                return false;
+            }
+            number = static_cast<int>(parsed);
+            return true;
+        }
+
+        bool parseDuration(const std::string &value, std::chrono::microseconds &duration) {
+            float number;
+            if (value.size() > 2 && value.compare(value.size() - 2, 2, "ms") == 0) {
+                if (!parseNumber(value.substr(0, value.size() - 2), number)) {
+                    return false;
+                }
+                number *= 1000.0f;
+            } else if (value.size() > 1 && value.back() == 's') {
+                if (!parseNumber(value.substr(0, value.size() - 1), number)) {
+                    return false;
+                }
+                number *= 1000000.0f;
+            } else {
+                return false;
+            }
+            if (number < 0.0f) {
+                return false;
+            }
+            duration = std::chrono::microseconds(static_cast<int64_t>(number));
+            return true;
+        }
+
+        bool parseEasing(const std::string &value, Easing &easing) {
+            static const std::unordered_map<std::string, Easing> easings{
+                {"linear",    Easing::Linear},
+                {"ease",      Easing::Ease},
+                {"easein",    Easing::EaseIn},
+                {"easeout",   Easing::EaseOut},
+                {"easeinout", Easing::EaseInOut}
+            };
+            auto search = easings.find(propertyKey(value));
+            if (search == easings.cend()) {
+                return false;
+            }
+            easing = search->second;
+            return true;
+        }
+
+        int lineAt(const std::string &source, std::size_t position) {
+            return 1 + static_cast<int>(std::count(source.cbegin(), source.cbegin() + std::min(position, source.size()), '\n'));
+        }
+    }
+
+    std::string StyleParser::normalizeSelector(const std::string &selector) {
+        std::string spaced{};
+        for (char c: selector) {
+            if (c == '>') {
+                spaced += " > ";
+            } else {
+                spaced += static_cast<char>(::isspace(c) ? ' ' : ::tolower(c));
+            }
+        }
+        std::string normalized{};
+        for (const auto &part: string_utils::split(spaced, ' ')) {
+            if (part.empty()) {
+                continue;
+            }
+            if (!normalized.empty()) {
+                normalized += ' ';
+            }
+            normalized += part;
+        }
+        return normalized;
+    }
+
+    bool StyleParser::parseDeclaration(const std::string &property, const std::string &value, Style *style, std::string *error) {
+        auto fail = [&error](const std::string &message) {
+            if (error) {
+                *error = message;
+            }
+            return false;
+        };
+
+        const auto &table = properties();
+        auto       info   = table.find(propertyKey(property));
+        if (info == table.cend()) {
+            return fail("Unknown property \"" + property + "\"");
+        }
+        if (value.empty()) {
+            return fail("Missing value for \"" + property + "\"");
+        }
+
+        switch (info->second.type) {
+            case PropertyType::Color: {
+                Color color;
+                if (!parseColor(value, color)) {
+                    return fail("Invalid color \"" + value + "\" for \"" + property + "\"");
+                }
+                style->set(static_cast<ColorProperty>(info->second.property), color);
+                return true;
+            }
+
+            case PropertyType::String: {
+                std::string string = value;
+                if (string.size() >= 2 && (string.front() == '"' || string.front() == '\'') && string.back() == string.front()) {
+                    string = string.substr(1, string.size() - 2);
+                }
+                if (info->second.property == StringProperty::transition) {
+                    // Kept as text, but rejected here rather than silently not animating
+                    std::vector<Transition> transitions{};
+                    std::string             transitionError{};
+                    if (!parseTransitions(string, transitions, &transitionError)) {
+                        return fail(transitionError);
+                    }
+                }
+                style->set(static_cast<StringProperty>(info->second.property), string);
+                return true;
+            }
+
+            case PropertyType::Float: {
+                std::string v = lowercase(value);
+                if (v == "auto") {
+                    style->set(static_cast<FloatProperty>(info->second.property), Style::Auto);
+                    return true;
+                }
+                if (v.back() == '%') {
+                    auto percent = table.find(propertyKey(property) + "percent");
+                    float number;
+                    if (percent == table.cend() || percent->second.type != PropertyType::Float) {
+                        return fail("\"" + property + "\" does not support percentages");
+                    }
+                    if (!parseNumber(v.substr(0, v.size() - 1), number)) {
+                        return fail("Invalid percentage \"" + value + "\" for \"" + property + "\"");
+                    }
+                    style->set(static_cast<FloatProperty>(percent->second.property), number / 100.0f);
+                    return true;
+                }
+                if (v.size() > 2 && v.compare(v.size() - 2, 2, "px") == 0) {
+                    v = v.substr(0, v.size() - 2);
+                }
+                float number;
+                if (!parseNumber(v, number)) {
+                    return fail("Invalid number \"" + value + "\" for \"" + property + "\"");
+                }
+                style->set(static_cast<FloatProperty>(info->second.property), number);
+                return true;
+            }
+
+            case PropertyType::Int: {
+                int number;
+                if (!parseInt(value, number)) {
+                    return fail("Invalid value \"" + value + "\" for \"" + property + "\"");
+                }
+                style->set(static_cast<IntProperty>(info->second.property), number);
+                return true;
+            }
+
+            case PropertyType::Bool: {
+                std::string v = lowercase(value);
+                if (v == "true" || v == "yes" || v == "1") {
+                    style->set(static_cast<BoolProperty>(info->second.property), true);
+                } else if (v == "false" || v == "no" || v == "0") {
+                    style->set(static_cast<BoolProperty>(info->second.property), false);
+                } else {
+                    return fail("Invalid boolean \"" + value + "\" for \"" + property + "\"");
+                }
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool StyleParser::parseTransitions(const std::string &value, std::vector<Transition> &transitions, std::string *error) {
+        auto fail = [&error](const std::string &message) {
+            if (error) {
+                *error = message;
+            }
+            return false;
+        };
+
+        const auto &table = properties();
+        for (const auto &entry: string_utils::split(value, ',')) {
+            std::vector<std::string> parts{};
+            for (const auto &part: string_utils::split(string_utils::trim_copy(entry), ' ')) {
+                if (!part.empty()) {
+                    parts.push_back(lowercase(part));
+                }
+            }
+            if (parts.empty()) {
+                continue;
+            }
+            if (parts.size() < 2 || parts.size() > 4) {
+                return fail("Invalid transition \"" + string_utils::trim_copy(entry) + "\"");
+            }
+
+            Transition transition{};
+            if (parts[0] != "all") {
+                auto info = table.find(propertyKey(parts[0]));
+                if (info == table.cend()) {
+                    return fail("Unknown property \"" + parts[0] + "\" in transition");
+                }
+                if (info->second.type == PropertyType::Color) {
+                    transition.type = Transition::Type::Color;
+                } else if (info->second.type == PropertyType::Float) {
+                    transition.type = Transition::Type::Float;
+                } else {
+                    return fail("\"" + parts[0] + "\" can't be animated");
+                }
+                transition.property = info->second.property;
+            }
+
+            if (!parseDuration(parts[1], transition.duration)) {
+                return fail("Invalid transition duration \"" + parts[1] + "\"");
+            }
+            // Easing and delay in any order, like CSS
+            for (std::size_t i = 2; i < parts.size(); ++i) {
+                if (!parseEasing(parts[i], transition.easing) && !parseDuration(parts[i], transition.delay)) {
+                    return fail("Invalid transition easing or delay \"" + parts[i] + "\"");
+                }
+            }
+            transitions.push_back(transition);
+        }
+        return true;
+    }
+
+    StyleParser::Declarations StyleParser::parse(const std::string &input, std::vector<Error> *errors) {
+        auto report = [&errors](int line, const std::string &message) {
+            if (errors) {
+                errors->push_back(Error{line, message});
+            }
+        };
+
+        // Blank out the comments, keeping the line breaks so that positions still give the right lines
+        std::string source = input;
+        for (std::size_t start = source.find("/*"); start != std::string::npos; start = source.find("/*", start)) {
+            std::size_t end = source.find("*/", start + 2);
+            std::size_t stop = end == std::string::npos ? source.size() : end + 2;
+            for (std::size_t i = start; i < stop; ++i) {
+                if (source[i] != '\n') {
+                    source[i] = ' ';
+                }
+            }
+            if (end == std::string::npos) {
+                report(lineAt(source, start), "Unterminated comment");
+                break;
+            }
+        }
+
+        Declarations declarations{};
+        std::size_t  position = 0;
+        while (position < source.size()) {
+            std::size_t open = source.find('{', position);
+            if (open == std::string::npos) {
+                if (!string_utils::trim_copy(source.substr(position)).empty()) {
+                    report(lineAt(source, position), "Expected \"{\" after selector");
+                }
+                break;
+            }
+            std::size_t close = source.find('}', open + 1);
+            if (close == std::string::npos) {
+                report(lineAt(source, open), "Unterminated rule");
+                break;
+            }
+
+            // Parse the block once, it is then shared by all the selectors of the rule
+            Style       block{};
+            std::size_t declarationStart = open + 1;
+            while (declarationStart < close) {
+                std::size_t declarationEnd = std::min(source.find(';', declarationStart), close);
+                std::string declaration    = string_utils::trim_copy(source.substr(declarationStart, declarationEnd - declarationStart));
+                if (!declaration.empty()) {
+                    int         line  = lineAt(source, source.find_first_not_of(" \t\r\n", declarationStart));
+                    auto        colon = declaration.find(':');
+                    std::string error{};
+                    if (colon == std::string::npos) {
+                        report(line, "Expected \":\" in \"" + declaration + "\"");
+                    } else if (!parseDeclaration(string_utils::trim_copy(declaration.substr(0, colon)), string_utils::trim_copy(declaration.substr(colon + 1)), &block, &error)) {
+                        report(line, error);
+                    }
+                }
+                declarationStart = declarationEnd + 1;
+            }
+
+            for (const auto &selectorString: string_utils::split(source.substr(position, open - position), ',')) {
+                std::string selector = normalizeSelector(selectorString);
+                if (selector.empty()) {
+                    report(lineAt(source, open), "Empty selector");
+                    continue;
+                }
+                auto &style = declarations[selector];
+                if (!style) {
+                    style = std::make_unique<Style>();
+                }
+                style->overlay(&block);
+            }
+
+            position = close + 1;
+        }
+
+        return declarations;
+    }
+
+}
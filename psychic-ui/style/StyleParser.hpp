@@ -0,0 +1,75 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Style.hpp"
+#include "Transition.hpp"
+
+namespace psychic_ui {
+
+    /**
+     * @class StyleParser
+     *
+     * Parses CSS-like text stylesheets into styles keyed by selector:
+     *
+     *     Button.primary:hover, Window > ToolBar .item {
+     *         background-color: #336699;
+     *         padding: 4;
+     *         width: 50%;
+     *         font-family: "stan0755";
+     *     }
+     *
+     * Selectors use the same syntax as `StyleManager::style`. Property names are the
+     * names of the Style property enums, either camel cased (`backgroundColor`) or
+     * dashed (`background-color`). Values are parsed according to the property type:
+     * - Colors: `#RGB`, `#RRGGBB`, `#AARRGGBB`, `0xAARRGGBB`, `rgb(r, g, b)`, `rgba(r, g, b, a)` or `transparent`
+     * - Floats: numbers with an optional `px` unit, `auto`, or percentages for properties with a `Percent` variant
+     * - Ints: numbers or cursor names (`arrow`, `ibeam`, `crosshair`, `hand`, `hresize`, `vresize`)
+     * - Bools: `true`/`false`
+     * - Strings: bare words or quoted strings
+     * - Transitions: `property duration [easing] [delay]` entries separated by commas, see Transition
+     *
+     * C style block comments are allowed anywhere. Invalid rules and declarations are
+     * reported and skipped, the rest of the stylesheet still loads.
+     */
+    class StyleParser {
+    public:
+        using Declarations = std::map<std::string, std::unique_ptr<Style>>;
+
+        struct Error {
+            int         line;
+            std::string message;
+        };
+
+        /**
+         * Parse stylesheet text
+         * Rules declared several times for the same selector are merged.
+         * @param source Stylesheet text
+         * @param errors Optional list receiving the parse errors
+         * @return Styles keyed by normalized selector
+         */
+        static Declarations parse(const std::string &source, std::vector<Error> *errors = nullptr);
+
+        /**
+         * Normalize a selector the way StyleManager keys its declarations
+         * Lowercase, single spaces between the parts, `>` as its own part.
+         */
+        static std::string normalizeSelector(const std::string &selector);
+
+        /**
+         * Parse a single declaration into a style
+         * @return Whether the property and value were valid
+         */
+        static bool parseDeclaration(const std::string &property, const std::string &value, Style *style, std::string *error = nullptr);
+
+        /**
+         * Parse the value of a `transition` property
+         * @param transitions List receiving the transitions, in declaration order
+         * @return Whether the whole value was valid
+         */
+        static bool parseTransitions(const std::string &value, std::vector<Transition> &transitions, std::string *error = nullptr);
+    };
+
+}
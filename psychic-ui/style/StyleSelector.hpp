@@ -26,6 +26,8 @@ namespace psychic_ui {
     };
 
     class StyleSelector {
+        friend class CompiledStyleSheet;
+
     public:
         static std::unique_ptr<StyleSelector> fromSelector(const std::string &selector);
 
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <cmath>
+#include "Transition.hpp"
+
+namespace psychic_ui {
+
+    namespace {
+
+        /**
+         * CSS cubic bezier from (0, 0) to (1, 1), solves x for t then returns y
+         */
+        float cubicBezier(const float x1, const float y1, const float x2, const float y2, const float x) {
+            auto curve = [](float p1, float p2, float t) {
+                return 3.0f * (1.0f - t) * (1.0f - t) * t * p1 + 3.0f * (1.0f - t) * t * t * p2 + t * t * t;
+            };
+            auto slope = [](float p1, float p2, float t) {
+                return 3.0f * (1.0f - t) * (1.0f - t) * p1 + 6.0f * (1.0f - t) * t * (p2 - p1) + 3.0f * t * t * (1.0f - p2);
+            };
+
+            // Newton iterations, falling back to bisection where the curve is too flat
+            float t = x;
+            for (int i = 0; i < 8; ++i) {
+                float error = curve(x1, x2, t) - x;
+                if (std::fabs(error) < 1e-5f) {
+                    return curve(y1, y2, t);
+                }
+                float d = slope(x1, x2, t);
+                if (std::fabs(d) < 1e-6f) {
+                    break;
+                }
+                t -= error / d;
+            }
+
+            float low  = 0.0f;
+            float high = 1.0f;
+            t = x;
+            for (int i = 0; i < 32; ++i) {
+                float value = curve(x1, x2, t);
+                if (std::fabs(value - x) < 1e-5f) {
+                    break;
+                }
+                if (value < x) {
+                    low = t;
+                } else {
+                    high = t;
+                }
+                t = (low + high) / 2.0f;
+            }
+            return curve(y1, y2, t);
+        }
+
+        uint8_t channel(const Color color, const int shift) {
+            return static_cast<uint8_t>((color >> shift) & 0xFF);
+        }
+    }
+
+    float ease(const Easing easing, const float t) {
+        if (t <= 0.0f) {
+            return 0.0f;
+        } else if (t >= 1.0f) {
+            return 1.0f;
+        }
+
+        switch (easing) {
+            case Easing::Linear:
+                return t;
+            case Easing::Ease:
+                return cubicBezier(0.25f, 0.1f, 0.25f, 1.0f, t);
+            case Easing::EaseIn:
+                return cubicBezier(0.42f, 0.0f, 1.0f, 1.0f, t);
+            case Easing::EaseOut:
+                return cubicBezier(0.0f, 0.0f, 0.58f, 1.0f, t);
+            case Easing::EaseInOut:
+                return cubicBezier(0.42f, 0.0f, 0.58f, 1.0f, t);
+        }
+        return t;
+    }
+
+    float interpolate(const float from, const float to, const float t) {
+        return from + (to - from) * t;
+    }
+
+    Color interpolate(const Color from, const Color to, const float t) {
+        Color color = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            float value = interpolate(static_cast<float>(channel(from, shift)), static_cast<float>(channel(to, shift)), t);
+            color |= static_cast<Color>(std::min(std::max(std::lround(value), 0L), 255L)) << shift;
+        }
+        return color;
+    }
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include "Style.hpp"
+
+namespace psychic_ui {
+
+    /**
+     * Timing functions of the CSS transitions
+     */
+    enum class Easing {
+        Linear,
+        Ease,
+        EaseIn,
+        EaseOut,
+        EaseInOut
+    };
+
+    /**
+     * Eased progress of an animation
+     * @param t Linear progress between 0 and 1
+     */
+    float ease(Easing easing, float t);
+
+    float interpolate(float from, float to, float t);
+
+    /**
+     * Interpolate each channel of two colors, alpha included
+     */
+    Color interpolate(Color from, Color to, float t);
+
+    /**
+     * @class Transition
+     *
+     * How a property animates when its computed value changes, declared with the `transition`
+     * style property:
+     *
+     *     transition: background-color 150ms ease-out, opacity 0.3s linear 100ms;
+     *
+     * Each entry is a property name (or `all`), a duration, then an optional easing
+     * (`linear`, `ease`, `ease-in`, `ease-out`, `ease-in-out`) and an optional delay.
+     * Only color and float properties can be animated.
+     */
+    struct Transition {
+        enum class Type {
+            All,
+            Color,
+            Float
+        };
+
+        Type                      type{Type::All};
+        int                       property{0};
+        std::chrono::microseconds duration{0};
+        std::chrono::microseconds delay{0};
+        Easing                    easing{Easing::Ease};
+
+        bool applies(ColorProperty colorProperty) const {
+            return type == Type::All || (type == Type::Color && property == colorProperty);
+        }
+
+        bool applies(FloatProperty floatProperty) const {
+            return type == Type::All || (type == Type::Float && property == floatProperty);
+        }
+    };
+
+}
@@ -84,19 +84,20 @@ public:
         int hugeText      = 36;
         int radius        = 7;
         int scrollBarSize = 12;
+        int skinPoolSize  = 256;
 
         manager->loadFont("Ubuntu Light", "../res/fonts/Ubuntu/Ubuntu-Light.ttf");
         manager->loadFont("Ubuntu Regular", "../res/fonts/Ubuntu/Ubuntu-Regular.ttf");
 
         manager->registerSkin("default-text-input-skin", SkinType::make([]() { return std::make_shared<DefaultTextInputSkin>(); }));
         manager->registerSkin("default-text-area-skin", SkinType::make([]() { return std::make_shared<DefaultTextAreaSkin>(); }));
-        manager->registerSkin("default-basic-button-skin", SkinType::make([]() { return std::make_shared<DefaultBasicButtonSkin>(); }));
-        manager->registerSkin("default-button-skin", SkinType::make([]() { return std::make_shared<DefaultButtonSkin>(); }));
-        manager->registerSkin("default-checkbox-skin", SkinType::make([]() { return std::make_shared<DefaultCheckBoxSkin>(); }));
+        manager->registerSkin("default-basic-button-skin", SkinType::make([]() { return std::make_shared<DefaultBasicButtonSkin>(); }), skinPoolSize);
+        manager->registerSkin("default-button-skin", SkinType::make([]() { return std::make_shared<DefaultButtonSkin>(); }), skinPoolSize);
+        manager->registerSkin("default-checkbox-skin", SkinType::make([]() { return std::make_shared<DefaultCheckBoxSkin>(); }), skinPoolSize);
         manager->registerSkin("default-scrollbar-skin", SkinType::make([]() { return std::make_shared<DefaultScrollBarSkin>(); }));
         manager->registerSkin("menu-button-skin", SkinType::make([]() { return std::make_shared<DefaultMenuButtonSkin>(); }));
         manager->registerSkin("sub-menu-button-skin", SkinType::make([]() { return std::make_shared<DefaultSubMenuButtonSkin>(); }));
-        manager->registerSkin("title-bar-button", SkinType::make([]() { return std::make_shared<TitleBarButtonSkin>(); }));
+        manager->registerSkinRenderer("title-bar-button", std::make_shared<TitleBarButtonSkin>());
         manager->registerSkin("slider", SkinType::make([]() { return std::make_shared<SliderRangeSkin>(); }));
 
         // region Defaults
@@ -192,6 +193,7 @@ public:
 
         // region Title Bar
         manager->style("TitleBar")
+               ->set(renderCache, true)
                ->set(alignItems, "center")
                ->set(height, 48)
                ->set(padding, 12)
@@ -467,6 +469,7 @@ public:
 
         // region MenuBar
         manager->style("MenuBar")
+               ->set(renderCache, true)
                ->set(flexDirection, "row")
                ->set(backgroundColor, themeBackgroundColor.getColorAlpha())
                ->set(borderBottom, 1)
@@ -492,6 +495,7 @@ public:
 
         // region ToolBar
         manager->style("ToolBar")
+               ->set(renderCache, true)
                ->set(flexDirection, "row")
                ->set(backgroundColor, themeLowContrastColor.getColorAlpha())
                ->set(borderBottom, 1)
@@ -0,0 +1,65 @@
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include "BinaryData.hpp"
+
+namespace psychic_ui {
+
+    namespace {
+        const std::size_t magicSize     = 4;
+        const uint32_t    byteOrderMark = 0x01020304;
+    }
+
+    void BinaryWriter::write(const uint8_t *bytes, const std::size_t size) {
+        data.insert(data.end(), bytes, bytes + size);
+    }
+
+    void BinaryWriter::writeHeader(const char *magic, const uint32_t version) {
+        write(reinterpret_cast<const uint8_t *>(magic), magicSize);
+        write(byteOrderMark);
+        write(version);
+    }
+
+    void BinaryWriter::save(const std::string &path, const std::string &name) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Could not open \"" + path + "\" to save the " + name);
+        }
+        file.write(reinterpret_cast<const char *>(data.data()), data.size());
+    }
+
+    BinaryReader::BinaryReader(const uint8_t *data, const std::size_t size, std::string name) :
+        _data(data),
+        _end(data + size),
+        _name(std::move(name)) {}
+
+    const uint8_t *BinaryReader::take(const std::size_t size) {
+        if (static_cast<std::size_t>(_end - _data) < size) {
+            throw std::runtime_error("Truncated " + _name);
+        }
+        const uint8_t *data = _data;
+        _data += size;
+        return data;
+    }
+
+    void BinaryReader::readHeader(const char *magic, const uint32_t version) {
+        if (std::memcmp(take(magicSize), magic, magicSize) != 0) {
+            throw std::runtime_error("Invalid " + _name + " header");
+        }
+        if (read<uint32_t>() != byteOrderMark) {
+            throw std::runtime_error("Byte order of the " + _name + " does not match this platform");
+        }
+        if (read<uint32_t>() != version) {
+            throw std::runtime_error("Unsupported " + _name + " version");
+        }
+    }
+
+    std::vector<uint8_t> BinaryReader::load(const std::string &path, const std::string &name) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Could not open " + name + " \"" + path + "\"");
+        }
+        return std::vector<uint8_t>{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace psychic_ui {
+
+    /**
+     * @class BinaryWriter
+     *
+     * Appends plain values to a buffer, used by the binary file formats
+     * (compiled stylesheets, input recordings). Values are written in the
+     * native byte order, the header lets readers reject files from another platform.
+     */
+    class BinaryWriter {
+    public:
+        std::vector<uint8_t> data{};
+
+        template<typename T>
+        void write(const T value) {
+            const auto bytes = reinterpret_cast<const uint8_t *>(&value);
+            data.insert(data.end(), bytes, bytes + sizeof(T));
+        }
+
+        void write(const uint8_t *bytes, std::size_t size);
+
+        /**
+         * Write the header checked by `BinaryReader::readHeader()`
+         * @param magic Four characters identifying the format
+         * @param version Version of the format
+         */
+        void writeHeader(const char *magic, uint32_t version);
+
+        /**
+         * Write the buffer to a file
+         * @param name Name of the format, for the error messages
+         */
+        void save(const std::string &path, const std::string &name) const;
+    };
+
+    /**
+     * @class BinaryReader
+     *
+     * Reads values written by a BinaryWriter, throwing a `std::runtime_error`
+     * instead of reading past the end of the data.
+     */
+    class BinaryReader {
+    public:
+        /**
+         * @param name Name of the format in lowercase, for the error messages
+         */
+        BinaryReader(const uint8_t *data, std::size_t size, std::string name);
+
+        template<typename T>
+        T read() {
+            T value;
+            std::memcpy(&value, take(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        const uint8_t *take(std::size_t size);
+
+        /**
+         * Check the header written by `BinaryWriter::writeHeader()`
+         * Throws a `std::runtime_error` if the magic, byte order or version don't match.
+         */
+        void readHeader(const char *magic, uint32_t version);
+
+        /**
+         * Read a whole file
+         * @param name Name of the format, for the error messages
+         */
+        static std::vector<uint8_t> load(const std::string &path, const std::string &name);
+
+    protected:
+        const uint8_t *_data;
+        const uint8_t *_end;
+        std::string   _name;
+    };
+
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cmath>
+#include "LatencyHistogram.hpp"
+
+namespace psychic_ui {
+
+    namespace {
+        const double firstLimit       = 64.0;
+        const double bucketsPerDouble = 4.0;
+    }
+
+    constexpr std::size_t LatencyHistogram::bucketCount;
+
+    void LatencyHistogram::add(const std::chrono::microseconds latency) {
+        int64_t value = std::max<int64_t>(0, latency.count());
+        ++_buckets[bucketFor(value)];
+        _min = _count == 0 ? value : std::min(_min, value);
+        _max = _count == 0 ? value : std::max(_max, value);
+        _sum += value;
+        ++_count;
+    }
+
+    void LatencyHistogram::clear() {
+        _buckets.fill(0);
+        _count = 0;
+        _min   = 0;
+        _max   = 0;
+        _sum   = 0;
+    }
+
+    std::chrono::microseconds LatencyHistogram::min() const {
+        return std::chrono::microseconds(_min);
+    }
+
+    std::chrono::microseconds LatencyHistogram::max() const {
+        return std::chrono::microseconds(_max);
+    }
+
+    std::chrono::microseconds LatencyHistogram::mean() const {
+        return std::chrono::microseconds(_count > 0 ? _sum / static_cast<int64_t>(_count) : 0);
+    }
+
+    std::chrono::microseconds LatencyHistogram::percentile(const double fraction) const {
+        if (_count == 0) {
+            return std::chrono::microseconds(0);
+        }
+
+        auto     rank = static_cast<uint64_t>(std::ceil(std::min(std::max(fraction, 0.0), 1.0) * _count));
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < bucketCount; ++i) {
+            seen += _buckets[i];
+            if (seen >= rank && seen > 0) {
+                // The bucket limit is an upper bound, the actual values can't be above the max or below the min
+                return std::chrono::microseconds(std::min(std::max(bucketLimit(i).count(), _min), _max));
+            }
+        }
+        return max();
+    }
+
+    std::chrono::microseconds LatencyHistogram::bucketLimit(const std::size_t bucket) {
+        return std::chrono::microseconds(
+            static_cast<int64_t>(std::ceil(firstLimit * std::pow(2.0, bucket / bucketsPerDouble)))
+        );
+    }
+
+    std::size_t LatencyHistogram::bucketFor(const int64_t microseconds) {
+        if (microseconds <= firstLimit) {
+            return 0;
+        }
+        auto bucket = static_cast<std::size_t>(std::ceil(bucketsPerDouble * std::log2(microseconds / firstLimit)));
+        // Rounding can put a value right at a limit in the next bucket
+        if (bucket > 0 && microseconds <= bucketLimit(bucket - 1).count()) {
+            --bucket;
+        }
+        return std::min(bucket, bucketCount - 1);
+    }
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace psychic_ui {
+
+    /**
+     * @class LatencyHistogram
+     *
+     * Distribution of latencies in logarithmic buckets, four per doubling starting at 64µs,
+     * so percentiles are within ~19% of the actual value from 64µs up to a few seconds.
+     * Adding a sample is constant time and the histogram never allocates, it can be fed
+     * every frame and read whenever, e.g. to print `percentile(0.95)` after a session.
+     */
+    class LatencyHistogram {
+    public:
+        static constexpr std::size_t bucketCount = 64;
+
+        void add(std::chrono::microseconds latency);
+        void clear();
+
+        uint64_t count() const {
+            return _count;
+        }
+
+        std::chrono::microseconds min() const;
+        std::chrono::microseconds max() const;
+        std::chrono::microseconds mean() const;
+
+        /**
+         * Latency under which a fraction of the samples are, within the bucket resolution
+         * @param fraction Between 0 and 1, 0.5 for the median, 0.99 for the 99th percentile
+         */
+        std::chrono::microseconds percentile(double fraction) const;
+
+        /**
+         * Upper bound of a bucket
+         */
+        static std::chrono::microseconds bucketLimit(std::size_t bucket);
+
+        const std::array<uint64_t, bucketCount> &buckets() const {
+            return _buckets;
+        }
+
+    protected:
+        std::array<uint64_t, bucketCount> _buckets{};
+        uint64_t                          _count{0};
+        int64_t                           _min{0};
+        int64_t                           _max{0};
+        int64_t                           _sum{0};
+
+        static std::size_t bucketFor(int64_t microseconds);
+    };
+
+}
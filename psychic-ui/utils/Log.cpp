@@ -0,0 +1,120 @@
+#include <iostream>
+#include "Log.hpp"
+
+namespace psychic_ui {
+    namespace log {
+
+        const char *levelName(const Level level) {
+            switch (level) {
+                case Level::Trace:
+                    return "trace";
+                case Level::Debug:
+                    return "debug";
+                case Level::Info:
+                    return "info";
+                case Level::Warning:
+                    return "warning";
+                case Level::Error:
+                    return "error";
+                default:
+                    return "off";
+            }
+        }
+
+        Logger &Logger::getInstance() {
+            static Logger instance{};
+            return instance;
+        }
+
+        Logger::Logger() :
+            _sink(&Logger::defaultSink) {}
+
+        Logger::~Logger() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_running) {
+                    return;
+                }
+                _running = false;
+            }
+            _wake.notify_one();
+            _thread.join();
+        }
+
+        Level Logger::level() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _level;
+        }
+
+        void Logger::setLevel(const Level level) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _level = level;
+        }
+
+        bool Logger::enabled(const Level level) const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return level >= _level && level != Level::Off;
+        }
+
+        void Logger::setSink(Sink sink) {
+            flush();
+            std::lock_guard<std::mutex> lock(_mutex);
+            _sink = sink ? std::move(sink) : Sink(&Logger::defaultSink);
+        }
+
+        void Logger::write(const Level level, std::string message) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_running) {
+                    start();
+                }
+                _messages.push_back(Message{level, std::move(message)});
+            }
+            _wake.notify_one();
+        }
+
+        void Logger::flush() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _flushed.wait(lock, [this]() { return _messages.empty() && !_busy; });
+        }
+
+        void Logger::start() {
+            // Called with the mutex held
+            _running = true;
+            _thread  = std::thread(&Logger::run, this);
+        }
+
+        void Logger::run() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true) {
+                _wake.wait(lock, [this]() { return !_messages.empty() || !_running; });
+                if (_messages.empty() && !_running) {
+                    break;
+                }
+
+                // Write the whole batch without holding the lock
+                std::deque<Message> batch{};
+                std::swap(batch, _messages);
+                Sink sink = _sink;
+                _busy = true;
+                lock.unlock();
+
+                for (const auto &message: batch) {
+                    sink(message.level, message.text);
+                }
+                std::cout.flush();
+                std::cerr.flush();
+
+                lock.lock();
+                _busy = false;
+                _flushed.notify_all();
+            }
+            _flushed.notify_all();
+        }
+
+        void Logger::defaultSink(const Level level, const std::string &message) {
+            std::ostream &out = level >= Level::Warning ? std::cerr : std::cout;
+            out << "[" << levelName(level) << "] " << message << '\n';
+        }
+    }
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/**
+ * Minimum log level compiled in, lower levels compile to nothing
+ * 0: trace, 1: debug, 2: info, 3: warning, 4: error, 5: off
+ */
+#ifndef PSYCHIC_UI_LOG_LEVEL
+#define PSYCHIC_UI_LOG_LEVEL 2
+#endif
+
+namespace psychic_ui {
+    namespace log {
+
+        enum class Level {
+            Trace   = 0,
+            Debug   = 1,
+            Info    = 2,
+            Warning = 3,
+            Error   = 4,
+            Off     = 5
+        };
+
+        const char *levelName(Level level);
+
+        using Sink = std::function<void(Level level, const std::string &message)>;
+
+        /**
+         * @class Logger
+         *
+         * Leveled logger writing from a background thread so that logging never
+         * blocks the UI thread on I/O. Messages are formatted on the calling thread,
+         * queued, and handed to the sink in order by the logging thread.
+         * Use the `PSYCHIC_LOG_*` macros rather than calling it directly, they
+         * compile out below `PSYCHIC_UI_LOG_LEVEL`.
+         */
+        class Logger {
+        public:
+            static Logger &getInstance();
+
+            Logger();
+            ~Logger();
+
+            /**
+             * Runtime level, on top of the compile-time one
+             */
+            Level level() const;
+            void setLevel(Level level);
+            bool enabled(Level level) const;
+
+            /**
+             * Replace the sink, by default info and lower go to stdout, warnings and errors to stderr
+             */
+            void setSink(Sink sink);
+
+            void write(Level level, std::string message);
+
+            /**
+             * Wait until every message written so far went through the sink
+             */
+            void flush();
+
+        protected:
+            struct Message {
+                Level       level;
+                std::string text;
+            };
+
+            Level                   _level{Level::Trace};
+            Sink                    _sink{nullptr};
+            std::deque<Message>     _messages{};
+            mutable std::mutex      _mutex{};
+            std::condition_variable _wake{};
+            std::condition_variable _flushed{};
+            std::thread             _thread{};
+            bool                    _running{false};
+            bool                    _busy{false};
+
+            void start();
+            void run();
+            static void defaultSink(Level level, const std::string &message);
+        };
+    }
+}
+
+#define PSYCHIC_LOG(level, expr) \
+    do { \
+        if (::psychic_ui::log::Logger::getInstance().enabled(level)) { \
+            std::ostringstream _psychicLogStream; \
+            _psychicLogStream << expr; \
+            ::psychic_ui::log::Logger::getInstance().write(level, _psychicLogStream.str()); \
+        } \
+    } while (0)
+
+#if PSYCHIC_UI_LOG_LEVEL <= 0
+#define PSYCHIC_LOG_TRACE(expr) PSYCHIC_LOG(::psychic_ui::log::Level::Trace, expr)
+#else
+#define PSYCHIC_LOG_TRACE(expr) do {} while (0)
+#endif
+
+#if PSYCHIC_UI_LOG_LEVEL <= 1
+#define PSYCHIC_LOG_DEBUG(expr) PSYCHIC_LOG(::psychic_ui::log::Level::Debug, expr)
+#else
+#define PSYCHIC_LOG_DEBUG(expr) do {} while (0)
+#endif
+
+#if PSYCHIC_UI_LOG_LEVEL <= 2
+#define PSYCHIC_LOG_INFO(expr) PSYCHIC_LOG(::psychic_ui::log::Level::Info, expr)
+#else
+#define PSYCHIC_LOG_INFO(expr) do {} while (0)
+#endif
+
+#if PSYCHIC_UI_LOG_LEVEL <= 3
+#define PSYCHIC_LOG_WARNING(expr) PSYCHIC_LOG(::psychic_ui::log::Level::Warning, expr)
+#else
+#define PSYCHIC_LOG_WARNING(expr) do {} while (0)
+#endif
+
+#if PSYCHIC_UI_LOG_LEVEL <= 4
+#define PSYCHIC_LOG_ERROR(expr) PSYCHIC_LOG(::psychic_ui::log::Level::Error, expr)
+#else
+#define PSYCHIC_LOG_ERROR(expr) do {} while (0)
+#endif
@@ -0,0 +1,59 @@
+#include "Pool.hpp"
+
+namespace psychic_ui {
+
+    BlockPool::BlockPool(const std::size_t blockSize, const std::size_t blocksPerChunk) :
+        _blockSize(blockSize),
+        _blocksPerChunk(blocksPerChunk > 0 ? blocksPerChunk : 1) {
+        // Every block has to be able to hold a free list link and keep the chunk alignment
+        const std::size_t alignment = alignof(std::max_align_t);
+        if (_blockSize < sizeof(FreeBlock)) {
+            _blockSize = sizeof(FreeBlock);
+        }
+        _blockSize = (_blockSize + alignment - 1) / alignment * alignment;
+    }
+
+    void *BlockPool::allocate() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_free) {
+            grow();
+        }
+        FreeBlock *block = _free;
+        _free = block->next;
+        ++_used;
+        return block;
+    }
+
+    void BlockPool::deallocate(void *block) {
+        if (!block) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto                        freeBlock = static_cast<FreeBlock *>(block);
+        freeBlock->next = _free;
+        _free = freeBlock;
+        --_used;
+    }
+
+    bool BlockPool::trim() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_used > 0) {
+            return false;
+        }
+        _free = nullptr;
+        _chunks.clear();
+        return true;
+    }
+
+    void BlockPool::grow() {
+        std::unique_ptr<unsigned char[]> chunk(new unsigned char[_blockSize * _blocksPerChunk]);
+        // Link the blocks in address order so that consecutive allocations are contiguous
+        for (std::size_t i = _blocksPerChunk; i > 0; --i) {
+            auto block = reinterpret_cast<FreeBlock *>(chunk.get() + (i - 1) * _blockSize);
+            block->next = _free;
+            _free = block;
+        }
+        _chunks.push_back(std::move(chunk));
+    }
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace psychic_ui {
+
+    /**
+     * @class BlockPool
+     *
+     * Fixed size block allocator. Blocks are carved out of large chunks and recycled
+     * through a free list, so allocating and releasing objects of a single type does not
+     * go through malloc/free and keeps them close together in memory. Chunks are only
+     * returned to the system when the pool is destroyed or trimmed while empty.
+     *
+     * Allocations are locked so that windows can restyle on several threads at once,
+     * the lock is uncontended on the UI thread alone.
+     */
+    class BlockPool {
+    public:
+        explicit BlockPool(std::size_t blockSize, std::size_t blocksPerChunk = 256);
+        BlockPool(const BlockPool &) = delete;
+        BlockPool &operator=(const BlockPool &) = delete;
+
+        void *allocate();
+        void deallocate(void *block);
+
+        /**
+         * Release the chunks if no block is in use
+         * @return Whether the memory was released
+         */
+        bool trim();
+
+        std::size_t blockSize() const {
+            return _blockSize;
+        }
+
+        std::size_t used() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _used;
+        }
+
+        std::size_t capacity() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _chunks.size() * _blocksPerChunk;
+        }
+
+    protected:
+        struct FreeBlock {
+            FreeBlock *next;
+        };
+
+        std::size_t                                   _blockSize;
+        std::size_t                                   _blocksPerChunk;
+        std::vector<std::unique_ptr<unsigned char[]>> _chunks{};
+        FreeBlock                                     *_free{nullptr};
+        std::size_t                                   _used{0};
+        mutable std::mutex                            _mutex{};
+
+        void grow();
+    };
+
+    /**
+     * Pool shared by every object of type T allocated through the pooled helpers
+     * It is intentionally never destroyed so that objects outliving static
+     * destruction can still be released.
+     */
+    template<class T>
+    BlockPool &poolFor() {
+        static auto *pool = new BlockPool(sizeof(T));
+        return *pool;
+    }
+
+    /**
+     * Standard allocator drawing single objects from `poolFor<T>()`
+     * Mostly useful with `std::allocate_shared`, which rebinds it to its control block type
+     * so that the object and its reference counts share a single pooled block.
+     */
+    template<class T>
+    class PoolAllocator {
+    public:
+        using value_type = T;
+
+        PoolAllocator() = default;
+
+        template<class U>
+        PoolAllocator(const PoolAllocator<U> &) {}
+
+        T *allocate(std::size_t n) {
+            if (n == 1) {
+                return static_cast<T *>(poolFor<T>().allocate());
+            }
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T *p, std::size_t n) {
+            if (n == 1) {
+                poolFor<T>().deallocate(p);
+            } else {
+                ::operator delete(p);
+            }
+        }
+
+        template<class U>
+        bool operator==(const PoolAllocator<U> &) const {
+            return true;
+        }
+
+        template<class U>
+        bool operator!=(const PoolAllocator<U> &) const {
+            return false;
+        }
+    };
+
+    /**
+     * Pooled equivalent of `std::make_shared`
+     * Use it to build large trees, e.g. `makePooled<Div>()` for the cells of a big table.
+     */
+    template<class T, class... Args>
+    std::shared_ptr<T> makePooled(Args &&... args) {
+        return std::allocate_shared<T>(PoolAllocator<T>{}, std::forward<Args>(args)...);
+    }
+
+}
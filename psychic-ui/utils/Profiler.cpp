@@ -0,0 +1,187 @@
+#include <fstream>
+#include <thread>
+#include "Profiler.hpp"
+
+namespace psychic_ui {
+    namespace profiler {
+
+        Profiler &Profiler::getInstance() {
+            static Profiler instance{};
+            return instance;
+        }
+
+        Profiler::Profiler(const size_t capacity) :
+            _events(capacity) {
+            for (auto &counter: _counters) {
+                counter = 0;
+            }
+        }
+
+        // region Settings
+
+        void Profiler::setCapacity(const size_t capacity) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _events.assign(capacity, Event{});
+            _next = 0;
+            _size = 0;
+        }
+
+        size_t Profiler::capacity() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _events.size();
+        }
+
+        void Profiler::setSlowFrameThreshold(const double milliseconds, const std::string &path) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _slowFrameThreshold = milliseconds;
+            _slowFramePath      = path;
+        }
+
+        // endregion
+
+        // region Recording
+
+        void Profiler::beginFrame() {
+            _frameStart = Clock::now();
+            for (auto &counter: _counters) {
+                counter = 0;
+            }
+        }
+
+        void Profiler::endFrame() {
+            auto end = Clock::now();
+            record("frame", _frameStart, end);
+
+            for (int i = 0; i < CounterCount; ++i) {
+                Event event{};
+                event.type      = Event::Value;
+                event.name      = counterName(static_cast<Counter>(i));
+                event.timestamp = microseconds(end);
+                event.duration  = _counters[i];
+                event.thread    = threadIndex();
+                event.frame     = _frame;
+                push(event);
+            }
+
+            bool        slow = false;
+            std::string path{};
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                slow = _slowFrameThreshold > 0.0
+                       && std::chrono::duration<double, std::milli>(end - _frameStart).count() > _slowFrameThreshold;
+                path = _slowFramePath;
+            }
+            if (slow) {
+                dump(path);
+            }
+
+            ++_frame;
+        }
+
+        uint64_t Profiler::frame() const {
+            return _frame;
+        }
+
+        void Profiler::record(const char *name, const Clock::time_point start, const Clock::time_point end) {
+            Event event{};
+            event.type      = Event::Scope;
+            event.name      = name;
+            event.timestamp = microseconds(start);
+            event.duration  = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+            event.thread    = threadIndex();
+            event.frame     = _frame;
+            push(event);
+        }
+
+        void Profiler::count(const Counter counter, const unsigned int amount) {
+            _counters[counter] += amount;
+        }
+
+        void Profiler::push(const Event &event) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_events.empty()) {
+                return;
+            }
+            _events[_next] = event;
+            _next = (_next + 1) % _events.size();
+            _size = std::min(_size + 1, _events.size());
+        }
+
+        std::vector<Event> Profiler::events() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::vector<Event>          events{};
+            events.reserve(_size);
+            size_t first = (_next + _events.size() - _size) % std::max(_events.size(), static_cast<size_t>(1));
+            for (size_t i = 0; i < _size; ++i) {
+                events.push_back(_events[(first + i) % _events.size()]);
+            }
+            return events;
+        }
+
+        void Profiler::clear() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _next = 0;
+            _size = 0;
+        }
+
+        // endregion
+
+        // region Export
+
+        void Profiler::dump(std::ostream &out) const {
+            out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            bool first = true;
+            for (const auto &event: events()) {
+                out << (first ? "" : ",") << std::endl;
+                first = false;
+                if (event.type == Event::Scope) {
+                    out << "{\"name\":\"" << event.name << "\",\"cat\":\"psychic-ui\",\"ph\":\"X\""
+                        << ",\"ts\":" << event.timestamp
+                        << ",\"dur\":" << event.duration
+                        << ",\"pid\":1,\"tid\":" << event.thread
+                        << ",\"args\":{\"frame\":" << event.frame << "}}";
+                } else {
+                    out << "{\"name\":\"" << event.name << "\",\"cat\":\"psychic-ui\",\"ph\":\"C\""
+                        << ",\"ts\":" << event.timestamp
+                        << ",\"pid\":1,\"tid\":" << event.thread
+                        << ",\"args\":{\"" << event.name << "\":" << event.duration << "}}";
+                }
+            }
+            out << std::endl << "]}" << std::endl;
+        }
+
+        bool Profiler::dump(const std::string &path) const {
+            std::ofstream file(path);
+            if (!file) {
+                return false;
+            }
+            dump(file);
+            return file.good();
+        }
+
+        // endregion
+
+        int64_t Profiler::microseconds(const Clock::time_point time) const {
+            return std::chrono::duration_cast<std::chrono::microseconds>(time - _epoch).count();
+        }
+
+        unsigned int Profiler::threadIndex() {
+            static std::atomic<unsigned int> nextIndex{0};
+            thread_local unsigned int        index = ++nextIndex;
+            return index;
+        }
+
+        const char *Profiler::counterName(const Counter counter) {
+            switch (counter) {
+                case Restyles:
+                    return "restyles";
+                case Measures:
+                    return "measures";
+                case LayoutUpdates:
+                    return "layoutUpdates";
+                default:
+                    return "unknown";
+            }
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace psychic_ui {
+    namespace profiler {
+
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * Per-frame counters
+         */
+        enum Counter {
+            Restyles,
+            Measures,
+            LayoutUpdates,
+            CounterCount
+        };
+
+        /**
+         * Profiled event, either a timed scope or the value of a counter for a frame
+         */
+        struct Event {
+            enum Type {
+                Scope,
+                Value
+            };
+
+            Type         type{Scope};
+            const char   *name{nullptr};
+            int64_t      timestamp{0}; // Microseconds since the profiler was created
+            int64_t      duration{0};  // Microseconds for scopes, counter value for values
+            unsigned int thread{0};
+            uint64_t     frame{0};
+        };
+
+        /**
+         * @class Profiler
+         *
+         * Records the timing of the frame phases and a few per-frame counters in a ring buffer.
+         * The buffer can be dumped as Chrome `trace_event` JSON (chrome://tracing, Perfetto)
+         * on demand, or automatically when a frame goes over a threshold.
+         *
+         * Instrumentation goes through the `PSYCHIC_PROFILE_*` macros which compile to nothing
+         * unless the library is built with `PSYCHIC_UI_PROFILER`.
+         */
+        class Profiler {
+        public:
+            static Profiler &getInstance();
+
+            explicit Profiler(size_t capacity = 65536);
+
+            /**
+             * Change the number of events kept, drops the recorded events
+             */
+            void setCapacity(size_t capacity);
+            size_t capacity() const;
+
+            /**
+             * Dump the trace automatically after a frame slower than the threshold
+             * @param milliseconds Threshold, 0 to disable
+             * @param path File to write the trace to
+             */
+            void setSlowFrameThreshold(double milliseconds, const std::string &path);
+
+            void beginFrame();
+            void endFrame();
+            uint64_t frame() const;
+
+            void record(const char *name, Clock::time_point start, Clock::time_point end);
+            void count(Counter counter, unsigned int amount = 1);
+
+            /**
+             * Recorded events, oldest first
+             */
+            std::vector<Event> events() const;
+            void clear();
+
+            void dump(std::ostream &out) const;
+            bool dump(const std::string &path) const;
+
+        protected:
+            Clock::time_point  _epoch{Clock::now()};
+            mutable std::mutex _mutex{};
+            std::vector<Event> _events{};
+            size_t             _next{0};
+            size_t             _size{0};
+
+            std::atomic<uint64_t>                                  _frame{0};
+            Clock::time_point                                      _frameStart{};
+            std::array<std::atomic<unsigned int>, CounterCount>    _counters{};
+
+            double      _slowFrameThreshold{0.0};
+            std::string _slowFramePath{};
+
+            int64_t microseconds(Clock::time_point time) const;
+            void push(const Event &event);
+            static unsigned int threadIndex();
+            static const char *counterName(Counter counter);
+        };
+
+        /**
+         * Records the time spent in a scope
+         */
+        class ProfileScope {
+        public:
+            explicit ProfileScope(const char *name) : _name(name), _start(Clock::now()) {}
+
+            ~ProfileScope() {
+                Profiler::getInstance().record(_name, _start, Clock::now());
+            }
+
+        protected:
+            const char        *_name;
+            Clock::time_point _start;
+        };
+
+        /**
+         * Delimits a frame, counters are reported and slow frames detected when it ends
+         */
+        class FrameScope {
+        public:
+            FrameScope() {
+                Profiler::getInstance().beginFrame();
+            }
+
+            ~FrameScope() {
+                Profiler::getInstance().endFrame();
+            }
+        };
+    }
+}
+
+#ifdef PSYCHIC_UI_PROFILER
+#define PSYCHIC_PROFILE_CONCAT_IMPL(a, b) a##b
+#define PSYCHIC_PROFILE_CONCAT(a, b) PSYCHIC_PROFILE_CONCAT_IMPL(a, b)
+#define PSYCHIC_PROFILE_SCOPE(name) ::psychic_ui::profiler::ProfileScope PSYCHIC_PROFILE_CONCAT(_profileScope, __LINE__){name}
+#define PSYCHIC_PROFILE_FRAME() ::psychic_ui::profiler::FrameScope PSYCHIC_PROFILE_CONCAT(_profileFrame, __LINE__){}
+#define PSYCHIC_PROFILE_COUNT(counter) ::psychic_ui::profiler::Profiler::getInstance().count(::psychic_ui::profiler::counter)
+#else
+#define PSYCHIC_PROFILE_SCOPE(name)
+#define PSYCHIC_PROFILE_FRAME()
+#define PSYCHIC_PROFILE_COUNT(counter)
+#endif
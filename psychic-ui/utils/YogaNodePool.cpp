@@ -0,0 +1,55 @@
+#include "YogaNodePool.hpp"
+
+namespace psychic_ui {
+
+    YogaNodePool &YogaNodePool::getInstance() {
+        // Leaked on purpose, divs can be destroyed during static destruction
+        static auto *instance = new YogaNodePool();
+        return *instance;
+    }
+
+    YogaNodePool::YogaNodePool(const std::size_t capacity) :
+        _capacity(capacity) {
+        _nodes.reserve(capacity < 1024 ? capacity : 1024);
+    }
+
+    YogaNodePool::~YogaNodePool() {
+        for (auto node: _nodes) {
+            YGNodeFree(node);
+        }
+    }
+
+    YGNodeRef YogaNodePool::acquire() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_nodes.empty()) {
+            return YGNodeNew();
+        }
+        YGNodeRef node = _nodes.back();
+        _nodes.pop_back();
+        return node;
+    }
+
+    void YogaNodePool::release(YGNodeRef node) {
+        if (!node) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        // Attached nodes are freed, which detaches them from their owner and children
+        if (_nodes.size() >= _capacity || YGNodeGetOwner(node) != nullptr || YGNodeGetChildCount(node) > 0) {
+            YGNodeFree(node);
+            return;
+        }
+        YGNodeReset(node);
+        _nodes.push_back(node);
+    }
+
+    void YogaNodePool::setCapacity(const std::size_t capacity) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _capacity = capacity;
+        while (_nodes.size() > _capacity) {
+            YGNodeFree(_nodes.back());
+            _nodes.pop_back();
+        }
+    }
+
+}
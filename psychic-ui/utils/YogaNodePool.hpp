@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include <yoga/Yoga.h>
+
+namespace psychic_ui {
+
+    /**
+     * @class YogaNodePool
+     *
+     * Recycles Yoga nodes instead of freeing them. Released nodes are reset with
+     * `YGNodeReset` and handed back by `acquire`, which saves the allocation and the
+     * default style initialization when building and tearing down large trees.
+     * Yoga has no allocation hooks, so this is done at the node level.
+     *
+     * Only detached leaf nodes can be recycled, nodes with a parent or children
+     * are freed as usual. Nodes are created and freed under the pool lock, which
+     * also keeps Yoga's global node counter consistent when windows build skins
+     * on several threads.
+     */
+    class YogaNodePool {
+    public:
+        static YogaNodePool &getInstance();
+
+        explicit YogaNodePool(std::size_t capacity = 16384);
+        ~YogaNodePool();
+        YogaNodePool(const YogaNodePool &) = delete;
+        YogaNodePool &operator=(const YogaNodePool &) = delete;
+
+        /**
+         * Get a node in its default state, from the pool when possible
+         */
+        YGNodeRef acquire();
+
+        /**
+         * Give a node back to the pool, or free it when it can't be recycled
+         */
+        void release(YGNodeRef node);
+
+        /**
+         * Maximum number of nodes kept around for recycling, extra nodes are freed
+         */
+        void setCapacity(std::size_t capacity);
+
+        std::size_t capacity() const {
+            return _capacity;
+        }
+
+        std::size_t available() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _nodes.size();
+        }
+
+    protected:
+        std::size_t            _capacity;
+        std::vector<YGNodeRef> _nodes{};
+        mutable std::mutex     _mutex{};
+    };
+
+}
@@ -0,0 +1,35 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include "catch2/catch.hpp"
+#include <psychic-ui/Div.hpp>
+#include <psychic-ui/components/DataContainer.hpp>
+
+using namespace psychic_ui;
+
+TEST_CASE("data containers rebuild their children under a cached parent", "[components]") {
+    auto parent = std::make_shared<Div>();
+    parent->style()
+          ->set(renderCache, true)
+          ->set(width, 100.0f)
+          ->set(height, 100.0f);
+
+    auto container = std::make_shared<DataContainer<std::string>>(
+        std::vector<std::string>{"a", "b"},
+        [](const std::string &item) {
+            auto div = std::make_shared<Div>();
+            div->setId(item);
+            return div;
+        }
+    );
+    parent->add(container);
+
+    REQUIRE(parent->renderToImage() != nullptr);
+    REQUIRE(container->childCount() == 2);
+
+    // The parent now replays its recording, the new data must still get rendered
+    container->setData({"c"});
+    REQUIRE(parent->renderToImage() != nullptr);
+    REQUIRE(container->childCount() == 1);
+    REQUIRE(container->children()[0]->id() == "c");
+}
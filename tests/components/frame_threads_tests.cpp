@@ -0,0 +1,113 @@
+#include <memory>
+#include <thread>
+#include "catch2/catch.hpp"
+#include <SkImage.h>
+#include <SkPixmap.h>
+#include <psychic-ui/Div.hpp>
+#include <psychic-ui/Skin.hpp>
+#include <psychic-ui/Window.hpp>
+#include <psychic-ui/applications/HeadlessApplication.hpp>
+#include <psychic-ui/components/Button.hpp>
+#include <psychic-ui/signals/CoalescingSignal.hpp>
+#include <psychic-ui/style/StyleManager.hpp>
+
+using namespace psychic_ui;
+
+namespace {
+    SkColor pixel(const sk_sp<SkImage> &image, const int x, const int y) {
+        SkPixmap pixmap;
+        REQUIRE(image != nullptr);
+        REQUIRE(image->peekPixels(&pixmap));
+        return pixmap.getColor(x, y);
+    }
+
+    class SharedButtonSkin : public ButtonSkin {
+    };
+
+    /**
+     * Emits from its style updates, which run on the frame threads
+     */
+    class RestyledDiv : public Div {
+    public:
+        explicit RestyledDiv(CoalescingSignal<int> &restyled) : Div(), _restyled(restyled) {}
+
+    protected:
+        void styleUpdated() override {
+            Div::styleUpdated();
+            int once = 1;
+            _restyled.emit(once);
+        }
+
+        CoalescingSignal<int> &_restyled;
+    };
+}
+
+TEST_CASE("windows sharing a style manager render on the frame threads", "[components]") {
+    HeadlessApplication application{};
+    application.init();
+    application.setFrameThreads(2);
+
+    auto manager = std::make_shared<StyleManager>();
+    manager->registerSkin("shared", SkinType::make([]() { return std::make_shared<SharedButtonSkin>(); }), 4);
+    manager->style(".swatch")
+           ->set(backgroundColor, 0xFFFF0000)
+           ->set(width, 8.0f)
+           ->set(height, 8.0f);
+    manager->style("button")->set(skin, "shared");
+    manager->style("buttonskin")->set(color, 0xFF000000);
+
+    CoalescingSignal<int> restyled{
+        [](const std::tuple<int> &pending, const std::tuple<int> &incoming) {
+            return std::make_tuple(std::get<0>(pending) + std::get<0>(incoming));
+        }
+    };
+    int             restyles = 0;
+    std::thread::id deliveredOn{};
+    restyled.subscribe(
+        [&restyles, &deliveredOn](int count) {
+            restyles += count;
+            deliveredOn = std::this_thread::get_id();
+        }
+    );
+
+    std::shared_ptr<Window> windows[2];
+    std::shared_ptr<Button> buttons[2];
+    for (int i = 0; i < 2; ++i) {
+        windows[i] = std::make_shared<Window>("Frame threads");
+        windows[i]->setStyleManager(manager);
+        windows[i]->appContainer()->add<RestyledDiv>(restyled)->addClassName("swatch");
+        buttons[i] = windows[i]->appContainer()->add<Button>("Button");
+        application.open(windows[i]);
+    }
+
+    REQUIRE(application.step() == 2);
+    REQUIRE(restyles >= 2);
+    REQUIRE(deliveredOn == std::this_thread::get_id());
+
+    for (int i = 0; i < 20; ++i) {
+        const Color background = i % 2 ? 0xFFFF0000 : 0xFF0000FF;
+        const Color text       = i % 2 ? 0xFF000000 : 0xFFFFFFFF;
+        manager->style(".swatch")->set(backgroundColor, background);
+        manager->style("buttonskin")->set(color, text);
+
+        restyles = 0;
+        REQUIRE(application.step() == 2);
+        REQUIRE(restyles >= 2);
+        REQUIRE_FALSE(CoalescingSignalBase::hasPending());
+
+        for (int w = 0; w < 2; ++w) {
+            REQUIRE(pixel(application.systemWindow(windows[w])->snapshot(), 4, 4) == background);
+
+            auto buttonSkin = std::dynamic_pointer_cast<SharedButtonSkin>(buttons[w]->skin());
+            REQUIRE(buttonSkin != nullptr);
+            REQUIRE(buttonSkin->computedStyle()->get(color) == text);
+        }
+        REQUIRE(buttons[0]->skin() != buttons[1]->skin());
+    }
+
+    for (int w = 0; w < 2; ++w) {
+        REQUIRE(application.systemWindow(windows[w])->frameCount() == 21);
+    }
+
+    application.shutdown();
+}
@@ -0,0 +1,83 @@
+#include <memory>
+#include "catch2/catch.hpp"
+#include <psychic-ui/Div.hpp>
+#include <psychic-ui/Window.hpp>
+#include <psychic-ui/applications/HeadlessApplication.hpp>
+#include <psychic-ui/style/StyleManager.hpp>
+
+using namespace psychic_ui;
+
+TEST_CASE("hit tests go through transforms set by restyles", "[components]") {
+    HeadlessApplication application{};
+    application.init();
+
+    auto manager = std::make_shared<StyleManager>();
+    manager->style(".translated")->set(translateX, 200.0f);
+    manager->style(".scaled")->set(scale, 4.0f);
+    manager->style(".rotated")
+           ->set(rotate, 45.0f)
+           ->set(translateY, -20.0f);
+
+    auto window = std::make_shared<Window>("Hit tests");
+    window->setStyleManager(manager);
+
+    // 20x20 at 100,100 in the window, the child's 10x10 in its top left corner
+    auto container = window->appContainer()->add<Div>();
+    container->style()
+             ->set(position, "absolute")
+             ->set(left, 100.0f)
+             ->set(top, 100.0f)
+             ->set(width, 20.0f)
+             ->set(height, 20.0f)
+             ->set(overflow, "visible");
+    auto child = container->add<Div>();
+    child->style()
+         ->set(width, 10.0f)
+         ->set(height, 10.0f);
+
+    int hits = 0;
+    child->onMouseDown.subscribe(
+        [&hits](const int /*mouseX*/, const int /*mouseY*/, const MouseButton /*button*/, const Mod /*modifiers*/) {
+            ++hits;
+        }
+    );
+
+    application.open(window);
+    application.step();
+    HeadlessSystemWindow *systemWindow = application.systemWindow(window);
+
+    auto clickAt = [&](const int x, const int y) {
+        hits = 0;
+        systemWindow->click(x, y);
+        application.step();
+        return hits > 0;
+    };
+
+    REQUIRE(clickAt(105, 105));
+
+    // Class changes only restyle, nothing is laid out again
+    SECTION("translated") {
+        child->addClassName("translated");
+        application.step();
+        REQUIRE(clickAt(305, 105));
+        REQUIRE_FALSE(clickAt(105, 105));
+    }
+
+    SECTION("scaled") {
+        child->addClassName("scaled");
+        application.step();
+        REQUIRE(clickAt(122, 122));
+        REQUIRE(clickAt(86, 86));
+        REQUIRE_FALSE(clickAt(127, 105));
+    }
+
+    SECTION("rotated") {
+        child->addClassName("rotated");
+        application.step();
+        // Tip of the diamond, and the corner of the square it was before rotating
+        REQUIRE(clickAt(105, 79));
+        REQUIRE_FALSE(clickAt(100, 80));
+    }
+
+    application.shutdown();
+}
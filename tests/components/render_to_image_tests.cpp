@@ -0,0 +1,61 @@
+#include <memory>
+#include <string>
+#include "catch2/catch.hpp"
+#include <SkImage.h>
+#include <SkPixmap.h>
+#include <psychic-ui/Div.hpp>
+#include <psychic-ui/Window.hpp>
+#include <psychic-ui/applications/HeadlessApplication.hpp>
+#include <psychic-ui/style/StyleManager.hpp>
+
+using namespace psychic_ui;
+
+namespace {
+    SkColor pixel(const sk_sp<SkImage> &image, const int x, const int y) {
+        SkPixmap pixmap;
+        REQUIRE(image != nullptr);
+        REQUIRE(image->peekPixels(&pixmap));
+        return pixmap.getColor(x, y);
+    }
+}
+
+TEST_CASE("detached trees render to images while the application runs", "[components]") {
+    HeadlessApplication application{};
+    application.init();
+
+    auto manager = std::make_shared<StyleManager>();
+    manager->style(".swatch")
+           ->set(backgroundColor, 0xFFFF0000)
+           ->set(width, 8.0f)
+           ->set(height, 8.0f);
+
+    auto window = std::make_shared<Window>("Render to image");
+    window->setStyleManager(manager);
+    window->appContainer()->add<Div>()->addClassName("swatch");
+    application.open(window);
+
+    auto root = std::make_shared<Div>();
+    root->addClassName("swatch");
+    root->setStyleManager(manager);
+
+    auto image = Div::renderToImageAsync(root);
+
+    // The main thread keeps restyling and drawing with the same manager
+    for (int i = 0; i < 20; ++i) {
+        manager->style(".swatch-" + std::to_string(i))->set(backgroundColor, 0xFF00FF00);
+        manager->style(".swatch")->set(backgroundColor, i % 2 ? 0xFFFF0000 : 0xFF0000FF);
+        application.step();
+    }
+
+    // Styled as it was when the render was requested
+    REQUIRE(pixel(image.get(), 4, 4) == 0xFFFF0000);
+    REQUIRE(root->styleManager() == manager.get());
+    REQUIRE(pixel(application.systemWindow(window)->snapshot(), 4, 4) == 0xFFFF0000);
+
+    // Back on the shared manager afterwards
+    manager->style(".swatch")->set(backgroundColor, 0xFF0000FF);
+    root->setStyleManager(manager);
+    REQUIRE(pixel(root->renderToImage(), 4, 4) == 0xFF0000FF);
+
+    application.shutdown();
+}
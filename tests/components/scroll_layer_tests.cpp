@@ -0,0 +1,78 @@
+#include <memory>
+#include <vector>
+#include "catch2/catch.hpp"
+#include <SkImage.h>
+#include <SkPixmap.h>
+#include <psychic-ui/Div.hpp>
+#include <psychic-ui/Window.hpp>
+#include <psychic-ui/applications/HeadlessApplication.hpp>
+
+using namespace psychic_ui;
+
+namespace {
+    SkColor pixel(const sk_sp<SkImage> &image, const int x, const int y) {
+        SkPixmap pixmap;
+        REQUIRE(image != nullptr);
+        REQUIRE(image->peekPixels(&pixmap));
+        return pixmap.getColor(x, y);
+    }
+
+    class LayerDiv : public Div {
+    public:
+        using Div::_scrollLayerRect;
+    };
+}
+
+TEST_CASE("scroll layers only rasterize around the viewport", "[components]") {
+    HeadlessApplication application{};
+    application.init();
+
+    auto window = std::make_shared<Window>("Scroll layer");
+
+    // 20x20 viewport on ten 20x20 stripes, red and blue
+    auto viewport = window->appContainer()->add<LayerDiv>();
+    viewport->style()
+            ->set(position, "absolute")
+            ->set(left, 0.0f)
+            ->set(top, 0.0f)
+            ->set(width, 20.0f)
+            ->set(height, 20.0f)
+            ->set(overflow, "scroll");
+    std::vector<std::shared_ptr<Div>> stripes{};
+    for (int i = 0; i < 10; ++i) {
+        auto stripe = viewport->add<Div>();
+        stripe->style()
+              ->set(width, 20.0f)
+              ->set(height, 20.0f)
+              ->set(shrink, 0.0f)
+              ->set(backgroundColor, i % 2 ? 0xFF0000FF : 0xFFFF0000);
+        stripes.push_back(stripe);
+    }
+
+    application.open(window);
+    HeadlessSystemWindow *systemWindow = application.systemWindow(window);
+    application.step();
+    REQUIRE(pixel(systemWindow->snapshot(), 10, 10) == 0xFFFF0000);
+    REQUIRE(viewport->_scrollLayerRect == SkIRect::MakeXYWH(0, 0, 20, 20));
+
+    // Out of the layer, it gets half a viewport of margin along the scrolling axis
+    viewport->setScrollY(-100);
+    application.step();
+    REQUIRE(pixel(systemWindow->snapshot(), 10, 10) == 0xFF0000FF);
+    REQUIRE(viewport->_scrollLayerRect == SkIRect::MakeXYWH(0, 90, 20, 40));
+
+    // Within the margin, the layer only moves
+    viewport->setScrollY(-105);
+    application.step();
+    REQUIRE(pixel(systemWindow->snapshot(), 10, 10) == 0xFF0000FF);
+    REQUIRE(pixel(systemWindow->snapshot(), 10, 17) == 0xFFFF0000);
+    REQUIRE(viewport->_scrollLayerRect == SkIRect::MakeXYWH(0, 90, 20, 40));
+
+    // Content changes only rasterize what is visible
+    stripes[5]->style()->set(backgroundColor, 0xFF00FF00);
+    application.step();
+    REQUIRE(pixel(systemWindow->snapshot(), 10, 10) == 0xFF00FF00);
+    REQUIRE(viewport->_scrollLayerRect == SkIRect::MakeXYWH(0, 105, 20, 20));
+
+    application.shutdown();
+}
@@ -0,0 +1,120 @@
+#include <memory>
+#include <string>
+#include "catch2/catch.hpp"
+#include <psychic-ui/Skin.hpp>
+#include <psychic-ui/components/Button.hpp>
+#include <psychic-ui/components/CheckBox.hpp>
+#include <psychic-ui/style/StyleManager.hpp>
+
+using namespace psychic_ui;
+
+namespace {
+    class RecordingButtonSkin : public ButtonSkin {
+    public:
+        std::string label{};
+
+        void setLabel(const std::string &l) override {
+            label = l;
+        }
+    };
+
+    class CountingButtonRenderer : public SkinRenderer<Button> {
+    public:
+        int         draws{0};
+        std::string label{};
+    protected:
+        void drawComponent(Button *component, SkCanvas */*canvas*/) override {
+            ++draws;
+            label = component->label();
+        }
+    };
+}
+
+TEST_CASE("skin pools", "[components]") {
+
+    SECTION("only keep unshared skins, up to their capacity") {
+        SkinPool pool{1};
+
+        auto shared = std::make_shared<ButtonSkin>();
+        pool.release(shared);
+        REQUIRE(pool.size() == 0);
+
+        pool.release(std::make_shared<ButtonSkin>());
+        pool.release(std::make_shared<ButtonSkin>());
+        REQUIRE(pool.size() == 1);
+
+        REQUIRE(pool.acquire() != nullptr);
+        REQUIRE(pool.size() == 0);
+        REQUIRE(pool.acquire() == nullptr);
+    }
+
+    SECTION("released skins forget their component") {
+        auto manager = std::make_shared<StyleManager>();
+        manager->registerSkin("recording", SkinType::make([]() { return std::make_shared<RecordingButtonSkin>(); }), 4);
+        manager->style("button")->set(skin, "recording");
+        manager->style("buttonskin")->set(color, 0xFF00FF00);
+
+        auto first = std::make_shared<Button>("First");
+        first->setStyleManager(manager);
+        first->updateStyleRecursive();
+        auto skin = std::dynamic_pointer_cast<RecordingButtonSkin>(first->skin());
+        REQUIRE(skin != nullptr);
+        REQUIRE(skin->label == "First");
+        REQUIRE(skin->computedStyle()->get(color) == 0xFF00FF00);
+
+        // Detached components hand their skin back when destroyed
+        RecordingButtonSkin *pooled = skin.get();
+        skin.reset();
+        first.reset();
+        REQUIRE(manager->skinPool("recording")->size() == 1);
+        REQUIRE(pooled->label.empty());
+        REQUIRE_FALSE(pooled->computedStyle()->has(color));
+        REQUIRE(pooled->parent() == nullptr);
+
+        auto second = std::make_shared<Button>("Second");
+        second->setStyleManager(manager);
+        second->updateStyleRecursive();
+        REQUIRE(second->skin().get() == pooled);
+        REQUIRE(pooled->label == "Second");
+        REQUIRE(pooled->computedStyle()->get(color) == 0xFF00FF00);
+        REQUIRE(manager->skinPool("recording")->size() == 0);
+    }
+}
+
+TEST_CASE("skin renderers", "[components]") {
+    auto manager  = std::make_shared<StyleManager>();
+    auto renderer = std::make_shared<CountingButtonRenderer>();
+    manager->registerSkinRenderer("counting", renderer);
+    manager->style("button")
+           ->set(skin, "counting")
+           ->set(width, 20.0f)
+           ->set(height, 10.0f);
+    manager->style("checkbox")
+           ->set(skin, "counting")
+           ->set(width, 20.0f)
+           ->set(height, 10.0f);
+
+    SECTION("draw the components without a skin of their own") {
+        auto button = std::make_shared<Button>("Label");
+        button->setStyleManager(manager);
+        button->layoutDetached();
+        REQUIRE(button->skin() == nullptr);
+        REQUIRE(button->childCount() == 0);
+
+        button->setLabel("Changed");
+        REQUIRE(button->renderToImage() != nullptr);
+        REQUIRE(renderer->draws == 1);
+        REQUIRE(renderer->label == "Changed");
+    }
+
+    SECTION("are not used for components they can't draw") {
+        auto checkBox = std::make_shared<CheckBox>("Label", nullptr);
+        checkBox->setStyleManager(manager);
+        checkBox->layoutDetached();
+        REQUIRE(checkBox->skin() == nullptr);
+
+        checkBox->setLabel("Changed");
+        REQUIRE(checkBox->renderToImage() != nullptr);
+        REQUIRE(renderer->draws == 0);
+    }
+}
@@ -0,0 +1,43 @@
+#include <memory>
+#include "catch2/catch.hpp"
+#include <psychic-ui/Window.hpp>
+#include <psychic-ui/applications/HeadlessApplication.hpp>
+
+using namespace psychic_ui;
+
+TEST_CASE("input latency is measured up to the frame the input caused", "[input]") {
+    HeadlessApplication application{};
+    application.init();
+    application.frameScheduler().setSkipIdleFrames(true);
+
+    auto window = std::make_shared<Window>("Latency");
+    application.open(window);
+    HeadlessSystemWindow *systemWindow = application.systemWindow(window);
+    application.step();
+
+    SECTION("queued input gets a frame") {
+        systemWindow->keyDown(Key::A);
+        application.step();
+        REQUIRE(systemWindow->frameCount() == 2);
+        REQUIRE(systemWindow->dispatchLatency().count() == 1);
+        REQUIRE(systemWindow->inputLatency().count() == 1);
+    }
+
+    SECTION("input that changes nothing is not counted at a later frame") {
+        // Raw input is dispatched right away, nothing has the focus to handle the key
+        window->setRawInput(true);
+        systemWindow->keyDown(Key::A);
+        REQUIRE(systemWindow->dispatchLatency().count() == 1);
+
+        application.step();
+        REQUIRE(systemWindow->frameCount() == 1);
+
+        window->requestFrame();
+        application.step();
+        REQUIRE(systemWindow->frameCount() == 2);
+        REQUIRE(systemWindow->dispatchLatency().count() == 1);
+        REQUIRE(systemWindow->inputLatency().count() == 0);
+    }
+
+    application.shutdown();
+}
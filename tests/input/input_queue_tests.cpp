@@ -0,0 +1,80 @@
+#include "catch2/catch.hpp"
+#include <psychic-ui/InputQueue.hpp>
+
+using namespace psychic_ui;
+
+static std::vector<InputEvent> drain(InputQueue &queue) {
+    std::vector<InputEvent> events{};
+    queue.drain([&events](const InputEvent &event) { events.push_back(event); });
+    return events;
+}
+
+TEST_CASE("input queue coalesces events between frames", "[input]") {
+    InputQueue queue{};
+    Mod        mod{};
+
+    SECTION("consecutive mouse moves keep the latest position") {
+        queue.push(InputEvent::mouseMove(1, 1, 0, mod));
+        queue.push(InputEvent::mouseMove(2, 2, 0, mod));
+        queue.push(InputEvent::mouseMove(3, 4, 0, mod));
+        REQUIRE(queue.size() == 1);
+
+        auto events = drain(queue);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].mouseX == 3);
+        REQUIRE(events[0].mouseY == 4);
+        REQUIRE(queue.empty());
+    }
+
+    SECTION("consecutive scrolls are summed") {
+        queue.push(InputEvent::mouseScroll(1, 1, 0.0, 1.0));
+        queue.push(InputEvent::mouseScroll(2, 2, 0.5, 2.0));
+        auto events = drain(queue);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].mouseX == 2);
+        REQUIRE(events[0].scrollX == 0.5);
+        REQUIRE(events[0].scrollY == 3.0);
+    }
+
+    SECTION("buttons split mouse moves and keep their ordering") {
+        queue.push(InputEvent::mouseMove(1, 1, 0, mod));
+        queue.push(InputEvent::mouseMove(2, 2, 0, mod));
+        queue.push(InputEvent::mouseButton(2, 2, MouseButton::LEFT, true, mod));
+        queue.push(InputEvent::mouseMove(3, 3, MouseButton::LEFT, mod));
+        queue.push(InputEvent::mouseMove(4, 4, MouseButton::LEFT, mod));
+        queue.push(InputEvent::mouseButton(4, 4, MouseButton::LEFT, false, mod));
+
+        auto events = drain(queue);
+        REQUIRE(events.size() == 4);
+        REQUIRE(events[0].type == InputEventType::MouseMove);
+        REQUIRE(events[0].mouseX == 2);
+        REQUIRE(events[1].type == InputEventType::MouseButton);
+        REQUIRE(events[1].down);
+        REQUIRE(events[2].type == InputEventType::MouseMove);
+        REQUIRE(events[2].mouseX == 4);
+        REQUIRE(events[3].type == InputEventType::MouseButton);
+        REQUIRE(!events[3].down);
+    }
+
+    SECTION("keys and characters are never merged") {
+        queue.push(InputEvent::keyDown(Key::A, mod));
+        queue.push(InputEvent::characterInput("a"));
+        queue.push(InputEvent::keyRepeat(Key::A, mod));
+        queue.push(InputEvent::characterInput("a"));
+        queue.push(InputEvent::keyUp(Key::A, mod));
+        REQUIRE(drain(queue).size() == 5);
+    }
+
+    SECTION("events queued while draining are kept for the next frame") {
+        queue.push(InputEvent::keyDown(Key::A, mod));
+        std::size_t count = 0;
+        queue.drain(
+            [&queue, &count, &mod](const InputEvent &/*event*/) {
+                ++count;
+                queue.push(InputEvent::keyUp(Key::A, mod));
+            }
+        );
+        REQUIRE(count == 1);
+        REQUIRE(queue.size() == 1);
+    }
+}
@@ -0,0 +1,56 @@
+#include "catch2/catch.hpp"
+#include <stdexcept>
+#include <psychic-ui/InputRecording.hpp>
+
+using namespace psychic_ui;
+
+TEST_CASE("input recordings round trip through their binary form", "[input]") {
+    Mod mod{};
+    mod.shift = true;
+    mod.super = true;
+
+    InputRecording recording{};
+    recording.add(std::chrono::microseconds(0), InputEvent::resize(800, 600));
+    recording.add(std::chrono::microseconds(1500), InputEvent::mouseMove(10, 20, 1, mod));
+    recording.add(std::chrono::microseconds(1500), InputEvent::mouseButton(10, 20, MouseButton::RIGHT, true, mod));
+    recording.add(std::chrono::microseconds(20000), InputEvent::mouseScroll(5, 6, 0.5, -2.25));
+    recording.add(std::chrono::microseconds(35000), InputEvent::keyDown(Key::A, mod));
+    recording.add(std::chrono::microseconds(35010), InputEvent::characterInput(icu::UnicodeString::fromUTF8("é")));
+    recording.add(std::chrono::microseconds(40000), InputEvent::keyUp(Key::A, Mod{}));
+
+    auto data   = recording.serialize();
+    auto loaded = InputRecording::deserialize(data.data(), data.size());
+
+    SECTION("events keep their time and fields") {
+        REQUIRE(loaded.size() == recording.size());
+        REQUIRE(loaded.duration() == std::chrono::microseconds(40000));
+
+        const auto &entries = loaded.entries();
+        REQUIRE(entries[0].event.type == InputEventType::Resize);
+        REQUIRE(entries[0].event.width == 800);
+        REQUIRE(entries[0].event.height == 600);
+
+        REQUIRE(entries[1].time == std::chrono::microseconds(1500));
+        REQUIRE(entries[1].event.mouseX == 10);
+        REQUIRE(entries[1].event.buttons == 1);
+        REQUIRE(entries[1].event.modifiers.shift);
+        REQUIRE(entries[1].event.modifiers.super);
+        REQUIRE_FALSE(entries[1].event.modifiers.ctrl);
+
+        REQUIRE(entries[2].event.button == MouseButton::RIGHT);
+        REQUIRE(entries[2].event.down);
+
+        REQUIRE(entries[3].time == std::chrono::microseconds(20000));
+        REQUIRE(entries[3].event.scrollY == -2.25);
+
+        REQUIRE(entries[4].event.key == Key::A);
+        REQUIRE(entries[5].event.character == icu::UnicodeString::fromUTF8("é"));
+        REQUIRE(entries[6].event.type == InputEventType::KeyUp);
+        REQUIRE_FALSE(entries[6].event.modifiers.shift);
+    }
+
+    SECTION("truncated data is rejected") {
+        REQUIRE_THROWS_AS(InputRecording::deserialize(data.data(), data.size() - 1), std::runtime_error);
+        REQUIRE_THROWS_AS(InputRecording::deserialize(data.data(), 3), std::runtime_error);
+    }
+}
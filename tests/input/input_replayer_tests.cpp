@@ -0,0 +1,94 @@
+#include <memory>
+#include "catch2/catch.hpp"
+#include <psychic-ui/Div.hpp>
+#include <psychic-ui/InputReplayer.hpp>
+#include <psychic-ui/Window.hpp>
+#include <psychic-ui/applications/HeadlessApplication.hpp>
+
+using namespace psychic_ui;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+TEST_CASE("input replays into a headless window", "[input]") {
+    HeadlessApplication application{};
+    application.init();
+
+    auto window = std::make_shared<Window>("Replay");
+    auto target = window->appContainer()->add<Div>();
+    target->style()
+          ->set(position, "absolute")
+          ->set(left, 0.0f)
+          ->set(top, 0.0f)
+          ->set(width, 50.0f)
+          ->set(height, 50.0f);
+
+    int moves  = 0;
+    int clicks = 0;
+    target->onMouseMove.subscribe(
+        [&moves](const int /*mouseX*/, const int /*mouseY*/, const int /*buttons*/, const Mod /*modifiers*/) {
+            ++moves;
+        }
+    );
+    target->onClick.subscribe([&clicks]() { ++clicks; });
+
+    application.open(window);
+    application.step();
+    HeadlessSystemWindow *systemWindow = application.systemWindow(window);
+
+    // Three moves and a click in the first frame, a resize in the second one
+    InputRecording recording{};
+    recording.add(microseconds(1000), InputEvent::mouseMove(5, 5, 0, Mod{}));
+    recording.add(microseconds(2000), InputEvent::mouseMove(10, 10, 0, Mod{}));
+    recording.add(microseconds(3000), InputEvent::mouseMove(20, 20, 0, Mod{}));
+    recording.add(microseconds(4000), InputEvent::mouseButton(20, 20, MouseButton::LEFT, true, Mod{}));
+    recording.add(microseconds(5000), InputEvent::mouseButton(20, 20, MouseButton::LEFT, false, Mod{}));
+    recording.add(microseconds(20000), InputEvent::resize(300, 200));
+
+    InputReplayer replayer{systemWindow, recording};
+
+    SECTION("advancing dispatches the merged events recorded so far") {
+        REQUIRE(replayer.advance(microseconds(2500)));
+        REQUIRE(moves == 1);
+        REQUIRE(replayer.timings().size() == 1);
+        REQUIRE(replayer.timings()[0].time == microseconds(2500));
+        REQUIRE(replayer.timings()[0].type == InputEventType::MouseMove);
+
+        REQUIRE(replayer.advance(microseconds(5000)));
+        REQUIRE(clicks == 1);
+        REQUIRE(replayer.timings().size() == 4);
+
+        REQUIRE_FALSE(replayer.advance(microseconds(20000)));
+        REQUIRE(replayer.done());
+    }
+
+    SECTION("running replays every event between frames") {
+        int frames = 0;
+        replayer.run(milliseconds(16), [&]() {
+            application.step();
+            ++frames;
+        });
+
+        // Nothing is due at 0, the click at 16ms, the resize at 32ms, then the last frame
+        REQUIRE(frames == 3);
+        REQUIRE(moves == 1);
+        REQUIRE(clicks == 1);
+        REQUIRE(window->getWidth() == 300);
+        REQUIRE(window->getHeight() == 200);
+
+        const auto &timings = replayer.timings();
+        REQUIRE(timings.size() == 4);
+        REQUIRE(timings[0].type == InputEventType::MouseMove);
+        REQUIRE(timings[1].type == InputEventType::MouseButton);
+        REQUIRE(timings[2].type == InputEventType::MouseButton);
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(timings[i].time == milliseconds(16));
+        }
+        REQUIRE(timings[3].type == InputEventType::Resize);
+        REQUIRE(timings[3].time == milliseconds(32));
+        for (const auto &timing: timings) {
+            REQUIRE(timing.duration.count() >= 0);
+        }
+    }
+
+    application.shutdown();
+}
@@ -0,0 +1,125 @@
+#include "catch2/catch.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+#include <psychic-ui/signals/CoalescingSignal.hpp>
+
+using namespace psychic_ui;
+
+TEST_CASE("coalescing signals deliver once per flush", "[signals]") {
+
+    SECTION("only the latest arguments are delivered") {
+        CoalescingSignal<int> signal{};
+        int                   calls = 0;
+        int                   last  = 0;
+        signal.subscribe(
+            [&calls, &last](int value) {
+                ++calls;
+                last = value;
+            }
+        );
+
+        for (int i = 1; i <= 10000; ++i) {
+            signal.emit(i);
+        }
+        REQUIRE(calls == 0);
+        REQUIRE(CoalescingSignalBase::hasPending());
+
+        CoalescingSignalBase::flushAll();
+        REQUIRE(calls == 1);
+        REQUIRE(last == 10000);
+        REQUIRE_FALSE(CoalescingSignalBase::hasPending());
+
+        CoalescingSignalBase::flushAll();
+        REQUIRE(calls == 1);
+    }
+
+    SECTION("a reducer merges the emissions") {
+        CoalescingSignal<int, float> signal{
+            [](const std::tuple<int, float> &pending, const std::tuple<int, float> &incoming) {
+                return std::make_tuple(
+                    std::get<0>(pending) + std::get<0>(incoming),
+                    std::max(std::get<1>(pending), std::get<1>(incoming))
+                );
+            }
+        };
+        int   sum = 0;
+        float max = 0.0f;
+        signal.subscribe(
+            [&sum, &max](int s, float m) {
+                sum = s;
+                max = m;
+            }
+        );
+
+        int   one = 1;
+        float a   = 3.0f;
+        float b   = 2.0f;
+        signal(one, a);
+        signal(one, b);
+        signal(one, b);
+        CoalescingSignalBase::flushAll();
+        REQUIRE(sum == 3);
+        REQUIRE(max == 3.0f);
+    }
+
+    SECTION("emissions from slots are delivered in the same flush") {
+        CoalescingSignal<int> first{};
+        CoalescingSignal<int> second{};
+        int                   received = 0;
+        first.subscribe([&second](int value) { second.emit(value); });
+        second.subscribe([&received](int value) { received = value; });
+
+        int value = 42;
+        first.emit(value);
+        CoalescingSignalBase::flushAll();
+        REQUIRE(received == 42);
+    }
+
+    SECTION("destroyed signals are not delivered") {
+        auto signal = std::make_unique<CoalescingSignal<int>>();
+        int value = 1;
+        signal->emit(value);
+        signal.reset();
+        CoalescingSignalBase::flushAll();
+        REQUIRE_FALSE(CoalescingSignalBase::hasPending());
+    }
+
+    SECTION("emissions from frame threads are delivered on the next flush") {
+        using Sum = CoalescingSignal<int>;
+        Sum shared{
+            [](const Sum::Arguments &pending, const Sum::Arguments &incoming) {
+                return Sum::Arguments{std::get<0>(pending) + std::get<0>(incoming)};
+            }
+        };
+        std::vector<std::unique_ptr<CoalescingSignal<int>>> own{};
+        int total    = 0;
+        int received = 0;
+        shared.subscribe([&total](int value) { total = value; });
+        for (int i = 0; i < 4; ++i) {
+            own.push_back(std::make_unique<CoalescingSignal<int>>());
+            own.back()->subscribe([&received](int /*value*/) { ++received; });
+        }
+
+        std::vector<std::thread> threads{};
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back(
+                [&shared, &own, i]() {
+                    for (int j = 0; j < 1000; ++j) {
+                        int one = 1;
+                        shared.emit(one);
+                        own[i]->emit(j);
+                    }
+                }
+            );
+        }
+        for (auto &thread: threads) {
+            thread.join();
+        }
+
+        CoalescingSignalBase::flushAll();
+        REQUIRE(total == 4000);
+        REQUIRE(received == 4);
+        REQUIRE_FALSE(CoalescingSignalBase::hasPending());
+    }
+}
@@ -0,0 +1,118 @@
+#include "catch2/catch.hpp"
+#include <string>
+#include <psychic-ui/signals/Signal.hpp>
+#include <psychic-ui/signals/Observer.hpp>
+
+using namespace psychic_ui;
+
+namespace {
+    class TestObserver : public Observer {
+    public:
+        int received = 0;
+
+        std::shared_ptr<Slot<int>> observe(Signal<int> &signal) {
+            return subscribeTo(signal, [this](int value) { received += value; });
+        }
+
+        void forget(std::shared_ptr<Slot<int>> slot) {
+            unsubscribeFrom(slot);
+        }
+    };
+}
+
+TEST_CASE("signals", "[signals]") {
+
+    SECTION("signals without subscriptions are a single pointer") {
+        REQUIRE(sizeof(Signal<int, int>) == sizeof(void *));
+        Signal<int> signal{};
+        REQUIRE_FALSE(signal.hasSubscriptions());
+        int value = 1;
+        signal.emit(value);
+    }
+
+    SECTION("slots are notified in subscription order") {
+        Signal<int, std::string> signal{};
+        std::string              order{};
+        signal.subscribe([&order](int value, std::string text) { order += std::to_string(value) + text; });
+        signal([&order](int, std::string text) { order += text; });
+        REQUIRE(signal.subscriptionCount() == 2);
+
+        int         value = 1;
+        std::string text  = "a";
+        signal.emit(value, text);
+        REQUIRE(order == "1aa");
+    }
+
+    SECTION("slots can unsubscribe while the signal is emitted") {
+        Signal<>                   signal{};
+        int                        first  = 0;
+        int                        second = 0;
+        std::shared_ptr<Slot<>>    secondSlot{nullptr};
+        std::shared_ptr<Slot<>>    firstSlot = signal.subscribe(
+            [&]() {
+                ++first;
+                firstSlot->disconnect();
+                secondSlot->disconnect();
+                firstSlot.reset();
+            }
+        );
+        secondSlot = signal.subscribe([&second]() { ++second; });
+
+        signal.emit();
+        REQUIRE(first == 1);
+        REQUIRE(second == 0);
+        REQUIRE_FALSE(signal.hasSubscriptions());
+        REQUIRE_FALSE(secondSlot->connected());
+
+        signal.emit();
+        REQUIRE(first == 1);
+    }
+
+    SECTION("slots subscribed while emitting are notified on the next emission") {
+        Signal<> signal{};
+        int      late = 0;
+        signal.subscribe([&]() { signal.subscribe([&late]() { ++late; }); });
+        signal.emit();
+        REQUIRE(late == 0);
+        signal.emit();
+        REQUIRE(late == 1);
+    }
+
+    SECTION("slots outliving their signal are disconnected") {
+        std::shared_ptr<Slot<>> slot{nullptr};
+        {
+            Signal<> signal{};
+            slot = signal.subscribe([]() {});
+            REQUIRE(slot->connected());
+        }
+        REQUIRE_FALSE(slot->connected());
+        slot->disconnect();
+    }
+
+    SECTION("observers disconnect their slots") {
+        Signal<int> signal{};
+        int         value = 2;
+        {
+            TestObserver observer{};
+            auto         slot = observer.observe(signal);
+            observer.observe(signal);
+            signal.emit(value);
+            REQUIRE(observer.received == 4);
+            observer.forget(slot);
+            signal.emit(value);
+            REQUIRE(observer.received == 6);
+        }
+        REQUIRE_FALSE(signal.hasSubscriptions());
+        signal.emit(value);
+    }
+
+    SECTION("large callbacks are supported") {
+        Signal<int> signal{};
+        std::string a{"a"}, b{"b"}, c{"c"};
+        std::string result{};
+        signal.subscribe([a, b, c, &result](int) { result = a + b + c; });
+        int value = 0;
+        signal.emit(value);
+        REQUIRE(result == "abc");
+    }
+}
@@ -0,0 +1,87 @@
+#include <functional>
+#include <memory>
+#include "catch2/catch.hpp"
+#include <psychic-ui/Animator.hpp>
+#include <psychic-ui/Div.hpp>
+
+using namespace psychic_ui;
+using std::chrono::milliseconds;
+
+namespace {
+    class CallbackDiv : public Div {
+    public:
+        std::function<void()> onStyleUpdated{nullptr};
+
+    protected:
+        void styleUpdated() override {
+            Div::styleUpdated();
+            if (onStyleUpdated) {
+                onStyleUpdated();
+            }
+        }
+    };
+
+    Transition timing(const milliseconds duration) {
+        Transition transition{};
+        transition.duration = duration;
+        transition.easing   = Easing::Linear;
+        return transition;
+    }
+}
+
+TEST_CASE("animator", "[style]") {
+    Animator &animator = Animator::getInstance();
+
+    SECTION("finished animations leave their end value") {
+        auto div = std::make_shared<Div>();
+        animator.animate(div.get(), opacity, 0.0f, 1.0f, timing(milliseconds(100)));
+        auto started = Animator::Clock::now();
+
+        animator.tick(started + milliseconds(50));
+        float halfway = div->computedStyle()->get(opacity);
+        REQUIRE(halfway >= 0.5f);
+        REQUIRE(halfway < 1.0f);
+
+        float to = 0.0f;
+        REQUIRE(animator.target(div.get(), opacity, to));
+        REQUIRE(to == 1.0f);
+
+        animator.tick(started + milliseconds(100));
+        REQUIRE(div->computedStyle()->get(opacity) == 1.0f);
+        REQUIRE_FALSE(animator.target(div.get(), opacity, to));
+    }
+
+    SECTION("retargeting replaces the running animation") {
+        auto div = std::make_shared<Div>();
+        animator.animate(div.get(), opacity, 0.0f, 1.0f, timing(milliseconds(100)));
+        animator.tick(Animator::Clock::now() + milliseconds(50));
+        float current = div->computedStyle()->get(opacity);
+        REQUIRE(current > 0.0f);
+
+        animator.animate(div.get(), opacity, current, 0.0f, timing(milliseconds(100)));
+        float to = 1.0f;
+        REQUIRE(animator.target(div.get(), opacity, to));
+        REQUIRE(to == 0.0f);
+
+        animator.tick(Animator::Clock::now() + milliseconds(100));
+        REQUIRE(div->computedStyle()->get(opacity) == 0.0f);
+        REQUIRE_FALSE(animator.target(div.get(), opacity, to));
+    }
+
+    SECTION("divs destroyed while a frame is applied are skipped") {
+        auto first  = std::make_shared<CallbackDiv>();
+        auto second = std::make_shared<Div>();
+        first->onStyleUpdated = [&second]() { second.reset(); };
+
+        animator.animate(first.get(), backgroundColor, 0xFF000000, 0xFFFFFFFF, timing(milliseconds(100)));
+        animator.animate(second.get(), opacity, 0.0f, 1.0f, timing(milliseconds(100)));
+
+        // Both finish this frame, the second one is destroyed when the first one is updated
+        animator.tick(Animator::Clock::now() + milliseconds(100));
+        REQUIRE(second == nullptr);
+        REQUIRE(first->computedStyle()->get(backgroundColor) == 0xFFFFFFFF);
+
+        Color to = 0;
+        REQUIRE_FALSE(animator.target(first.get(), backgroundColor, to));
+    }
+}
@@ -0,0 +1,79 @@
+#include <memory>
+#include "catch2/catch.hpp"
+#include <psychic-ui/Div.hpp>
+
+using namespace psychic_ui;
+
+namespace {
+    class CountingDiv : public Div {
+    public:
+        int restyles{0};
+        int layouts{0};
+
+        using Div::isValid;
+
+    protected:
+        void styleUpdated() override {
+            Div::styleUpdated();
+            ++restyles;
+        }
+
+        void layoutUpdated() override {
+            if (YGNodeGetHasNewLayout(_yogaNode)) {
+                ++layouts;
+            }
+            Div::layoutUpdated();
+        }
+    };
+}
+
+TEST_CASE("batches hold invalidation until the outermost batch ends", "[style]") {
+    auto root = std::make_shared<CountingDiv>();
+    root->style()->set(width, 100.0f)->set(height, 100.0f);
+    auto div = std::make_shared<CountingDiv>();
+    root->add(div);
+    root->layoutDetached();
+    REQUIRE(div->restyles == 1);
+    REQUIRE(div->layouts == 1);
+    REQUIRE(div->isValid());
+
+    SECTION("geometry is written to yoga once") {
+        {
+            Div::Batch batch{div.get()};
+            div->setSize(10, 20);
+            div->setLeft(5);
+            {
+                Div::Batch nested{div.get()};
+                div->setWidth(30);
+            }
+            REQUIRE(div->isValid());
+            REQUIRE(root->isValid());
+        }
+
+        REQUIRE_FALSE(div->isValid());
+        root->layoutDetached();
+        REQUIRE(div->restyles == 1);
+        REQUIRE(div->layouts == 2);
+        REQUIRE(div->getWidth() == 30);
+        REQUIRE(div->getHeight() == 20);
+        REQUIRE(div->getLeft() == 5);
+    }
+
+    SECTION("style changes restyle once") {
+        {
+            Div::Batch batch{div.get()};
+            div->style()->set(backgroundColor, 0xFF000000)->set(height, 20.0f);
+            div->addClassName("selected");
+            div->setId("batched");
+
+            root->updateDirtyStyles();
+            REQUIRE(div->restyles == 1);
+            REQUIRE(div->isValid());
+        }
+
+        root->layoutDetached();
+        REQUIRE(div->restyles == 2);
+        REQUIRE(div->layouts == 2);
+        REQUIRE(div->getHeight() == 20);
+    }
+}
@@ -0,0 +1,69 @@
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include "catch2/catch.hpp"
+#include <psychic-ui/style/StyleManager.hpp>
+#include <psychic-ui/style/CompiledStyleSheet.hpp>
+
+using namespace psychic_ui;
+
+TEST_CASE("compiled stylesheets", "[style]") {
+    auto source = std::make_shared<StyleManager>();
+    source->style("*")
+          ->set(fontFamily, "stylesheet")
+          ->set(fontSize, 12.0f);
+    source->style("Button.primary:hover")
+          ->set(backgroundColor, 0xFF336699)
+          ->set(cursor, Cursor::Hand)
+          ->set(antiAlias, true);
+    source->style("window > toolbar .item:first-child label")
+          ->set(padding, 4.0f)
+          ->set(textAlign, "center")
+          ->set(visible, false);
+
+    SECTION("round trip the declarations") {
+        auto data   = CompiledStyleSheet::compile(source.get());
+        auto loaded = std::make_shared<StyleManager>();
+        CompiledStyleSheet::load(loaded.get(), data.data(), data.size());
+
+        REQUIRE_FALSE(loaded->valid());
+        REQUIRE(*loaded->style("*") == *source->style("*"));
+        REQUIRE(*loaded->style("button.primary:hover") == *source->style("button.primary:hover"));
+        REQUIRE(*loaded->style("window > toolbar .item:first-child label") == *source->style("window > toolbar .item:first-child label"));
+        REQUIRE(loaded->style("button.primary:hover")->get(backgroundColor) == 0xFF336699);
+
+        // Compiling the loaded manager gives back the same declarations
+        REQUIRE(CompiledStyleSheet::compile(loaded.get()).size() == data.size());
+    }
+
+    SECTION("overlay existing declarations") {
+        auto data   = CompiledStyleSheet::compile(source.get());
+        auto loaded = std::make_shared<StyleManager>();
+        loaded->style("button.primary:hover")
+              ->set(color, 0xFFFFFFFF)
+              ->set(backgroundColor, 0xFF000000);
+        loaded->setValid();
+
+        CompiledStyleSheet::load(loaded.get(), data.data(), data.size());
+        REQUIRE_FALSE(loaded->valid());
+        REQUIRE(loaded->style("button.primary:hover")->get(color) == 0xFFFFFFFF);
+        REQUIRE(loaded->style("button.primary:hover")->get(backgroundColor) == 0xFF336699);
+    }
+
+    SECTION("load from a file") {
+        std::string path = "compiled_stylesheet_test.pss";
+        CompiledStyleSheet::save(source.get(), path);
+        auto loaded = std::make_shared<StyleManager>();
+        loaded->loadCompiledStyleSheet(path);
+        std::remove(path.c_str());
+        REQUIRE(*loaded->style("button.primary:hover") == *source->style("button.primary:hover"));
+    }
+
+    SECTION("reject invalid data") {
+        auto data   = CompiledStyleSheet::compile(source.get());
+        auto loaded = std::make_shared<StyleManager>();
+        REQUIRE_THROWS_AS(CompiledStyleSheet::load(loaded.get(), data.data(), data.size() - 3), std::runtime_error);
+        data[0] = 'X';
+        REQUIRE_THROWS_AS(CompiledStyleSheet::load(loaded.get(), data.data(), data.size()), std::runtime_error);
+    }
+}
@@ -0,0 +1,171 @@
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include "catch2/catch.hpp"
+#include <psychic-ui/style/StyleManager.hpp>
+#include <psychic-ui/style/StyleParser.hpp>
+#include <psychic-ui/Div.hpp>
+
+using namespace psychic_ui;
+
+namespace {
+    class RestyleCountingDiv : public Div {
+    public:
+        int restyles{0};
+
+    protected:
+        void styleUpdated() override {
+            Div::styleUpdated();
+            ++restyles;
+        }
+    };
+}
+
+TEST_CASE("stylesheet parser", "[style]") {
+
+    SECTION("parse values") {
+        auto declarations = StyleParser::parse(R"(
+            /* Buttons */
+            Button.primary:hover, Window>ToolBar  .item {
+                background-color: #336699;
+                borderColor: rgba(255, 0, 0, 0.5);
+                padding: 4px;
+                width: 50%;
+                height: auto;
+                cursor: hand;
+                anti-alias: false;
+                font-family: "stan0755";
+            }
+        )");
+
+        REQUIRE(declarations.size() == 2);
+        REQUIRE(declarations.count("button.primary:hover") == 1);
+        REQUIRE(declarations.count("window > toolbar .item") == 1);
+
+        const Style *style = declarations["button.primary:hover"].get();
+        REQUIRE(*style == *declarations["window > toolbar .item"]);
+        REQUIRE(style->get(backgroundColor) == 0xFF336699);
+        REQUIRE(style->get(borderColor) == 0x7FFF0000);
+        REQUIRE(style->get(padding) == 4.0f);
+        REQUIRE(style->get(widthPercent) == 0.5f);
+        REQUIRE_FALSE(style->has(width));
+        REQUIRE(style->has(height));
+        REQUIRE(style->get(cursor) == Cursor::Hand);
+        REQUIRE(style->get(antiAlias) == false);
+        REQUIRE(style->get(fontFamily) == "stan0755");
+    }
+
+    SECTION("merge rules for the same selector") {
+        auto declarations = StyleParser::parse("label { color: #fff; } LABEL { fontSize: 12; color: #000; }");
+        REQUIRE(declarations.size() == 1);
+        REQUIRE(declarations["label"]->get(color) == 0xFF000000);
+        REQUIRE(declarations["label"]->get(fontSize) == 12.0f);
+    }
+
+    SECTION("report errors and keep valid declarations") {
+        std::vector<StyleParser::Error> errors{};
+        auto                            declarations = StyleParser::parse(
+            "label {\n"
+            "    color: #ff;\n"
+            "    unknown: 1;\n"
+            "    fontSize: 12;\n"
+            "}\n"
+            "button {\n",
+            &errors
+        );
+        REQUIRE(errors.size() == 3);
+        REQUIRE(errors[0].line == 2);
+        REQUIRE(errors[1].line == 3);
+        REQUIRE(errors[2].line == 6);
+        REQUIRE(declarations.size() == 1);
+        REQUIRE_FALSE(declarations["label"]->has(color));
+        REQUIRE(declarations["label"]->get(fontSize) == 12.0f);
+    }
+
+    SECTION("reload watched stylesheets") {
+        std::string path = "style_parser_tests.pss";
+        std::ofstream(path) << "label { color: #fff; } button { fontSize: 12; }";
+
+        auto manager = std::make_shared<StyleManager>();
+        manager->style("label")->set(fontSize, 10.0f);
+        REQUIRE(manager->loadStyleSheetFile(path, true));
+        REQUIRE(manager->style("label")->get(color) == 0xFFFFFFFF);
+        REQUIRE(manager->style("label")->get(fontSize) == 10.0f);
+        manager->setValid();
+
+        // Nothing changed on disk
+        REQUIRE_FALSE(manager->reloadStyleSheets(true));
+
+        std::ofstream(path) << "label { color: #000; } /* button removed */";
+        REQUIRE(manager->reloadStyleSheets(true));
+        REQUIRE(manager->valid());
+        REQUIRE(manager->styleSheetRevision() == 1);
+        REQUIRE(manager->changedSelectors().size() == 2);
+        REQUIRE(manager->style("label")->get(color) == 0xFF000000);
+        REQUIRE(manager->style("label")->get(fontSize) == 10.0f);
+        REQUIRE_FALSE(manager->style("button")->has(fontSize));
+
+        std::remove(path.c_str());
+    }
+
+    SECTION("reloads keep the values set by other sources") {
+        std::string path = "style_parser_tests_sources.pss";
+        std::ofstream(path) << "label { color: #fff; font-size: 12; }";
+
+        auto manager = std::make_shared<StyleManager>();
+        manager->style("label")->set(color, 0xFFFF0000)->set(fontSize, 10.0f);
+        REQUIRE(manager->loadStyleSheetFile(path, true));
+        REQUIRE(manager->style("label")->get(color) == 0xFFFFFFFF);
+        REQUIRE(manager->style("label")->get(fontSize) == 12.0f);
+
+        // Replaced by code after the sheet was loaded
+        manager->style("label")->set(fontSize, 14.0f);
+
+        std::ofstream(path) << "label { letter-spacing: 1; }";
+        REQUIRE(manager->reloadStyleSheets(true));
+        REQUIRE(manager->style("label")->get(color) == 0xFFFF0000);
+        REQUIRE(manager->style("label")->get(fontSize) == 14.0f);
+        REQUIRE(manager->style("label")->get(letterSpacing) == 1.0f);
+
+        // Same size, right away
+        std::ofstream(path) << "label { letter-spacing: 2; }";
+        REQUIRE(manager->reloadStyleSheets(true));
+        REQUIRE(manager->style("label")->get(letterSpacing) == 2.0f);
+
+        std::remove(path.c_str());
+    }
+
+    SECTION("reloads only restyle the matching divs") {
+        std::string path = "style_parser_tests_invalidation.pss";
+        std::ofstream(path) << ".label { color: #fff; } .button { color: #fff; }";
+
+        auto manager = std::make_shared<StyleManager>();
+        REQUIRE(manager->loadStyleSheetFile(path, true));
+
+        auto root = std::make_shared<Div>();
+        root->setStyleManager(manager);
+        auto label = std::make_shared<RestyleCountingDiv>();
+        label->addClassName("label");
+        root->add(label);
+        auto button = std::make_shared<RestyleCountingDiv>();
+        button->addClassName("button");
+        root->add(button);
+        root->updateStyleRecursive();
+        manager->setValid();
+        REQUIRE(label->restyles == 1);
+        REQUIRE(button->restyles == 1);
+
+        std::ofstream(path) << ".label { color: #fff; } .button { color: #000000; }";
+        REQUIRE(manager->reloadStyleSheets(true));
+        REQUIRE(manager->valid());
+        manager->invalidateChanged(root.get());
+        root->updateDirtyStyles();
+
+        REQUIRE(label->restyles == 1);
+        REQUIRE(button->restyles == 2);
+        REQUIRE(button->computedStyle()->get(color) == 0xFF000000);
+        REQUIRE(label->computedStyle()->get(color) == 0xFFFFFFFF);
+
+        std::remove(path.c_str());
+    }
+}
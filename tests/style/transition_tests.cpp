@@ -0,0 +1,175 @@
+#include <memory>
+#include "catch2/catch.hpp"
+#include <psychic-ui/Animator.hpp>
+#include <psychic-ui/Div.hpp>
+#include <psychic-ui/Window.hpp>
+#include <psychic-ui/applications/HeadlessApplication.hpp>
+#include <psychic-ui/style/StyleManager.hpp>
+#include <psychic-ui/style/StyleParser.hpp>
+#include <psychic-ui/style/Transition.hpp>
+
+using namespace psychic_ui;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+namespace {
+    class TransitionApplication : public HeadlessApplication {
+    public:
+        std::chrono::microseconds idleTimeout() {
+            return ApplicationBase::idleTimeout(systemWindows());
+        }
+    };
+}
+
+TEST_CASE("transitions", "[style]") {
+
+    SECTION("parse transitions") {
+        std::vector<Transition> transitions{};
+        REQUIRE(StyleParser::parseTransitions("background-color 150ms ease-out, opacity 0.3s linear 100ms, all 1s", transitions));
+        REQUIRE(transitions.size() == 3);
+
+        REQUIRE(transitions[0].type == Transition::Type::Color);
+        REQUIRE(transitions[0].applies(backgroundColor));
+        REQUIRE_FALSE(transitions[0].applies(color));
+        REQUIRE(transitions[0].duration == milliseconds(150));
+        REQUIRE(transitions[0].easing == Easing::EaseOut);
+
+        REQUIRE(transitions[1].applies(opacity));
+        REQUIRE(transitions[1].duration == milliseconds(300));
+        REQUIRE(transitions[1].delay == milliseconds(100));
+        REQUIRE(transitions[1].easing == Easing::Linear);
+
+        REQUIRE(transitions[2].type == Transition::Type::All);
+        REQUIRE(transitions[2].applies(width));
+        REQUIRE(transitions[2].easing == Easing::Ease);
+    }
+
+    SECTION("transforms are animatable") {
+        std::vector<Transition> transitions{};
+        REQUIRE(StyleParser::parseTransitions("rotate 200ms, scale-x 1s ease-in", transitions));
+        REQUIRE(transitions.size() == 2);
+        REQUIRE(transitions[0].applies(rotate));
+        REQUIRE_FALSE(transitions[0].applies(scale));
+        REQUIRE(transitions[1].applies(scaleX));
+
+        auto declarations = StyleParser::parse("Menu { translate-y: -4; scale: 0.9; rotate: 45; }");
+        REQUIRE(declarations["menu"]->get(translateY) == -4.0f);
+        REQUIRE(declarations["menu"]->get(scale) == 0.9f);
+        REQUIRE(declarations["menu"]->get(rotate) == 45.0f);
+    }
+
+    SECTION("invalid transitions are rejected") {
+        std::vector<Transition> transitions{};
+        REQUIRE_FALSE(StyleParser::parseTransitions("opacity", transitions));
+        REQUIRE_FALSE(StyleParser::parseTransitions("opacity 10 parsecs", transitions));
+        REQUIRE_FALSE(StyleParser::parseTransitions("font-family 1s", transitions));
+
+        std::vector<StyleParser::Error> errors{};
+        auto declarations = StyleParser::parse("Button { transition: nope 1s; opacity: 0.5; }", &errors);
+        REQUIRE(errors.size() == 1);
+        REQUIRE_FALSE(declarations["button"]->has(transition));
+        REQUIRE(declarations["button"]->get(opacity) == 0.5f);
+    }
+
+    SECTION("easing") {
+        for (auto easing: {Easing::Linear, Easing::Ease, Easing::EaseIn, Easing::EaseOut, Easing::EaseInOut}) {
+            REQUIRE(ease(easing, 0.0f) == 0.0f);
+            REQUIRE(ease(easing, 1.0f) == 1.0f);
+            float previous = 0.0f;
+            for (int i = 1; i <= 20; ++i) {
+                float value = ease(easing, i / 20.0f);
+                REQUIRE(value >= previous - 1e-4f);
+                previous = value;
+            }
+        }
+        REQUIRE(ease(Easing::EaseInOut, 0.5f) == Approx(0.5f).margin(1e-3));
+        REQUIRE(ease(Easing::EaseIn, 0.25f) < 0.25f);
+        REQUIRE(ease(Easing::EaseOut, 0.25f) > 0.25f);
+    }
+
+    SECTION("interpolate colors per channel") {
+        REQUIRE(interpolate(static_cast<Color>(0x00000000), static_cast<Color>(0xFF0080FF), 0.5f) == 0x80004080);
+        REQUIRE(interpolate(static_cast<Color>(0xFF336699), static_cast<Color>(0x00000000), 1.0f) == 0x00000000);
+        REQUIRE(interpolate(10.0f, 20.0f, 0.25f) == 12.5f);
+    }
+}
+
+TEST_CASE("stylesheet transitions in a window", "[style]") {
+    TransitionApplication application{};
+    application.init();
+    application.frameScheduler().setSkipIdleFrames(true);
+    Animator &animator = Animator::getInstance();
+
+    auto manager = std::make_shared<StyleManager>();
+    manager->style(".fader")
+           ->set(opacity, 1.0f)
+           ->set(transition, "opacity 100ms linear");
+    manager->style(".fader.hidden")->set(opacity, 0.0f);
+    manager->style(".tinted")->set(backgroundColor, 0xFF00FF00);
+
+    auto window = std::make_shared<Window>("Transitions");
+    window->setStyleManager(manager);
+    auto div = window->appContainer()->add<Div>();
+    div->addClassName("fader");
+    application.open(window);
+    HeadlessSystemWindow *systemWindow = application.systemWindow(window);
+
+    application.step();
+    REQUIRE(div->computedStyle()->get(opacity) == 1.0f);
+    REQUIRE_FALSE(animator.active());
+    REQUIRE(application.idleTimeout() > microseconds(0));
+
+    // The restyle starts the animation from the current value
+    auto before = Animator::Clock::now();
+    div->addClassName("hidden");
+    application.step();
+    auto after = Animator::Clock::now();
+    REQUIRE(div->computedStyle()->get(opacity) == 1.0f);
+    REQUIRE(animator.active());
+    REQUIRE(application.idleTimeout() == microseconds(0));
+    float to = 1.0f;
+    REQUIRE(animator.target(div.get(), opacity, to));
+    REQUIRE(to == 0.0f);
+
+    // Linear from the restyle, which happened between before and after
+    animator.tick(after + milliseconds(30));
+    float halfway = div->computedStyle()->get(opacity);
+    REQUIRE(halfway <= 0.7f);
+    REQUIRE(halfway >= 0.7f - std::chrono::duration<float>(after - before) / std::chrono::duration<float>(milliseconds(100)));
+
+    SECTION("restyling toward the same value keeps the animation") {
+        div->addClassName("tinted");
+        window->updateDirtyStyles();
+        REQUIRE(div->computedStyle()->get(backgroundColor) == 0xFF00FF00);
+        REQUIRE(div->computedStyle()->get(opacity) == halfway);
+        REQUIRE(animator.target(div.get(), opacity, to));
+        REQUIRE(to == 0.0f);
+    }
+
+    SECTION("restyling toward another value retargets the animation") {
+        div->removeClassName("hidden");
+        window->updateDirtyStyles();
+        REQUIRE(div->computedStyle()->get(opacity) == halfway);
+        REQUIRE(animator.target(div.get(), opacity, to));
+        REQUIRE(to == 1.0f);
+
+        animator.tick(Animator::Clock::now() + milliseconds(100));
+        REQUIRE(div->computedStyle()->get(opacity) == 1.0f);
+    }
+
+    SECTION("idle frames are skipped again once the animation ends") {
+        animator.tick(Animator::Clock::now() + milliseconds(100));
+        REQUIRE(div->computedStyle()->get(opacity) == 0.0f);
+        REQUIRE_FALSE(animator.active());
+
+        // The last value is drawn, then nothing
+        application.step();
+        auto frames = systemWindow->frameCount();
+        application.step();
+        REQUIRE(systemWindow->frameCount() == frames);
+        REQUIRE(application.idleTimeout() > microseconds(0));
+    }
+
+    animator.cancel(div.get());
+    application.shutdown();
+}
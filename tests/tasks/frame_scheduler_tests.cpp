@@ -0,0 +1,119 @@
+#include <memory>
+#include "catch2/catch.hpp"
+#include <psychic-ui/Div.hpp>
+#include <psychic-ui/FrameScheduler.hpp>
+#include <psychic-ui/Window.hpp>
+#include <psychic-ui/applications/HeadlessApplication.hpp>
+
+using namespace psychic_ui;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+TEST_CASE("frame scheduler", "[tasks]") {
+    FrameScheduler scheduler{};
+    auto           now = FrameScheduler::Clock::now();
+
+    SECTION("frame deadlines don't accumulate debt") {
+        scheduler.setTargetRate(100.0);
+        REQUIRE(scheduler.frameInterval() == milliseconds(10));
+
+        scheduler.frameStarted(now);
+        REQUIRE(scheduler.nextFrame() == now + milliseconds(10));
+        scheduler.frameStarted(now + milliseconds(10));
+        REQUIRE(scheduler.nextFrame() == now + milliseconds(20));
+
+        // A long stall starts over from the late frame
+        scheduler.frameStarted(now + milliseconds(100));
+        REQUIRE(scheduler.nextFrame() == now + milliseconds(110));
+    }
+
+    SECTION("timeouts run once when due") {
+        int calls = 0;
+        scheduler.setTimeout(milliseconds(50), [&calls]() { ++calls; });
+        REQUIRE(scheduler.runTimers(now) == 0);
+        REQUIRE(scheduler.timeUntilNextTimer(now) > milliseconds(40));
+        REQUIRE(scheduler.runTimers(now + milliseconds(60)) == 1);
+        REQUIRE(scheduler.runTimers(now + milliseconds(120)) == 0);
+        REQUIRE(calls == 1);
+        REQUIRE(scheduler.timeUntilNextTimer(now) == microseconds::max());
+    }
+
+    SECTION("intervals repeat until cleared") {
+        int  calls = 0;
+        auto id    = scheduler.setInterval(milliseconds(10), [&calls]() { ++calls; });
+        scheduler.runTimers(now + milliseconds(15));
+        scheduler.runTimers(now + milliseconds(25));
+        REQUIRE(calls == 2);
+        scheduler.clearTimer(id);
+        scheduler.runTimers(now + milliseconds(100));
+        REQUIRE(calls == 2);
+    }
+
+    SECTION("frame callbacks run every frame until they return false") {
+        int frames = 0;
+        scheduler.addFrameCallback([&frames](FrameScheduler::Clock::time_point) { return ++frames < 3; });
+        REQUIRE(scheduler.hasFrameCallbacks());
+        for (int i = 0; i < 5; ++i) {
+            scheduler.runFrameCallbacks(now);
+        }
+        REQUIRE(frames == 3);
+        REQUIRE_FALSE(scheduler.hasFrameCallbacks());
+    }
+
+    SECTION("frame callbacks added while running wait for the next frame") {
+        int added = 0;
+        scheduler.addFrameCallback([&](FrameScheduler::Clock::time_point) {
+            scheduler.addFrameCallback([&added](FrameScheduler::Clock::time_point) {
+                ++added;
+                return false;
+            });
+            return false;
+        });
+        scheduler.runFrameCallbacks(now);
+        REQUIRE(added == 0);
+        scheduler.runFrameCallbacks(now);
+        REQUIRE(added == 1);
+    }
+}
+
+TEST_CASE("idle windows are only redrawn when asked to", "[tasks]") {
+    HeadlessApplication application{};
+    application.init();
+
+    auto window = std::make_shared<Window>("Idle");
+    auto div    = window->appContainer()->add<Div>();
+    application.open(window);
+    HeadlessSystemWindow *systemWindow = application.systemWindow(window);
+
+    application.step();
+    REQUIRE(systemWindow->frameCount() == 1);
+
+    SECTION("every frame is drawn by default") {
+        application.step();
+        REQUIRE(systemWindow->frameCount() == 2);
+    }
+
+    SECTION("idle frames are skipped") {
+        application.frameScheduler().setSkipIdleFrames(true);
+        REQUIRE(application.step() == 1);
+        REQUIRE(application.step() == 1);
+        REQUIRE(systemWindow->frameCount() == 1);
+
+        div->style()->set(width, 10.0f);
+        application.step();
+        REQUIRE(systemWindow->frameCount() == 2);
+
+        systemWindow->mouseMove(5, 5);
+        application.step();
+        REQUIRE(systemWindow->frameCount() == 3);
+
+        application.step();
+        REQUIRE(systemWindow->frameCount() == 3);
+
+        window->requestFrame();
+        application.step();
+        REQUIRE(systemWindow->frameCount() == 4);
+    }
+
+    application.shutdown();
+}
@@ -0,0 +1,60 @@
+#include "catch2/catch.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <psychic-ui/RenderThread.hpp>
+
+using namespace psychic_ui;
+
+TEST_CASE("render thread presents submitted frames", "[tasks]") {
+    std::atomic<int>             starts{0};
+    std::atomic<int>             stops{0};
+    std::atomic<int>             lastWidth{0};
+    std::atomic<std::thread::id> presentThread{};
+
+    auto thread = std::make_unique<RenderThread>(
+        [&starts]() { ++starts; },
+        [&lastWidth, &presentThread](const RenderThread::Frame &frame) {
+            presentThread = std::this_thread::get_id();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            lastWidth = frame.width;
+        },
+        [&stops]() { ++stops; }
+    );
+
+    SECTION("frames are presented off the submitting thread") {
+        thread->submit({nullptr, 10, 10});
+        thread->wait();
+        REQUIRE(lastWidth == 10);
+        REQUIRE(presentThread.load() != std::this_thread::get_id());
+        REQUIRE(thread->presented() == 1);
+    }
+
+    SECTION("waiting frames are replaced by newer ones") {
+        for (int i = 1; i <= 50; ++i) {
+            thread->submit({nullptr, i, i});
+        }
+        thread->wait();
+        REQUIRE(lastWidth == 50);
+        REQUIRE(thread->presented() + thread->dropped() == 50);
+    }
+
+    SECTION("tasks run on the render thread") {
+        std::thread::id taskThread{};
+        thread->submit({nullptr, 1, 1});
+        thread->sync([&taskThread]() { taskThread = std::this_thread::get_id(); });
+        REQUIRE(taskThread != std::this_thread::get_id());
+    }
+
+    SECTION("stopping presents the waiting frame") {
+        thread->submit({nullptr, 20, 20});
+        thread->stop();
+        REQUIRE(lastWidth == 20);
+        REQUIRE(stops == 1);
+    }
+
+    thread.reset();
+    REQUIRE(starts == 1);
+    REQUIRE(stops == 1);
+}
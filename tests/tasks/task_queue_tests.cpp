@@ -0,0 +1,66 @@
+#include "catch2/catch.hpp"
+#include <thread>
+#include <vector>
+#include <psychic-ui/TaskQueue.hpp>
+
+using namespace psychic_ui;
+
+TEST_CASE("task queue runs posted tasks on the consumer", "[tasks]") {
+    TaskQueue queue{};
+
+    SECTION("tasks run in posting order") {
+        std::vector<int> order{};
+        for (int i = 0; i < 10; ++i) {
+            queue.post([&order, i]() { order.push_back(i); });
+        }
+        REQUIRE_FALSE(queue.empty());
+        REQUIRE(queue.drain(std::chrono::seconds(1)) == 10);
+        REQUIRE(queue.empty());
+        REQUIRE(order == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    }
+
+    SECTION("the budget leaves tasks for the next drain") {
+        int count = 0;
+        for (int i = 0; i < 5; ++i) {
+            queue.post([&count]() { ++count; });
+        }
+        // A zero budget still runs one task to guarantee progress
+        REQUIRE(queue.drain(std::chrono::microseconds(0)) == 1);
+        REQUIRE(count == 1);
+        REQUIRE_FALSE(queue.empty());
+        REQUIRE(queue.drain(std::chrono::seconds(1)) == 4);
+        REQUIRE(count == 5);
+    }
+
+    SECTION("tasks posted from a task run in the same drain") {
+        int count = 0;
+        queue.post([&queue, &count]() { queue.post([&count]() { ++count; }); });
+        REQUIRE(queue.drain(std::chrono::seconds(1)) == 2);
+        REQUIRE(count == 1);
+    }
+
+    SECTION("multiple producers") {
+        const int                perThread = 10000;
+        std::vector<std::thread> producers{};
+        std::vector<int>         counts(4, 0);
+        for (int t = 0; t < 4; ++t) {
+            producers.emplace_back(
+                [&queue, &counts, t]() {
+                    for (int i = 0; i < perThread; ++i) {
+                        queue.post([&counts, t]() { ++counts[t]; });
+                    }
+                }
+            );
+        }
+
+        size_t total = 0;
+        while (total < 4 * perThread) {
+            total += queue.drain(std::chrono::milliseconds(1));
+        }
+        for (auto &producer: producers) {
+            producer.join();
+        }
+        REQUIRE(queue.empty());
+        REQUIRE(counts == std::vector<int>(4, perThread));
+    }
+}
@@ -0,0 +1,49 @@
+#include "catch2/catch.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <psychic-ui/ThreadPool.hpp>
+
+using namespace psychic_ui;
+
+TEST_CASE("thread pool runs every item once", "[tasks]") {
+    ThreadPool pool{3};
+    REQUIRE(pool.size() == 3);
+
+    SECTION("items are all run before returning") {
+        std::vector<int> results(100, 0);
+        pool.parallelFor(results.size(), [&results](std::size_t i) { results[i] = static_cast<int>(i) * 2; });
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            REQUIRE(results[i] == static_cast<int>(i) * 2);
+        }
+    }
+
+    SECTION("jobs can run back to back") {
+        std::atomic<int> total{0};
+        for (int job = 0; job < 50; ++job) {
+            pool.parallelFor(4, [&total](std::size_t) { ++total; });
+        }
+        REQUIRE(total == 200);
+    }
+
+    SECTION("exceptions are rethrown on the calling thread") {
+        std::atomic<int> ran{0};
+        REQUIRE_THROWS_AS(
+            pool.parallelFor(10, [&ran](std::size_t i) {
+                ++ran;
+                if (i == 5) {
+                    throw std::runtime_error("item failed");
+                }
+            }),
+            std::runtime_error
+        );
+        REQUIRE(ran == 10);
+    }
+}
+
+TEST_CASE("thread pool without workers runs on the calling thread", "[tasks]") {
+    ThreadPool pool{0};
+    int        total = 0;
+    pool.parallelFor(5, [&total](std::size_t i) { total += static_cast<int>(i); });
+    REQUIRE(total == 10);
+}
@@ -0,0 +1,56 @@
+#include "catch2/catch.hpp"
+#include <psychic-ui/utils/LatencyHistogram.hpp>
+
+using namespace psychic_ui;
+using std::chrono::microseconds;
+
+TEST_CASE("latency histogram", "[utils]") {
+    LatencyHistogram histogram{};
+
+    SECTION("empty histograms report zero") {
+        REQUIRE(histogram.count() == 0);
+        REQUIRE(histogram.percentile(0.5) == microseconds(0));
+        REQUIRE(histogram.mean() == microseconds(0));
+    }
+
+    SECTION("exact statistics") {
+        histogram.add(microseconds(1000));
+        histogram.add(microseconds(3000));
+        histogram.add(microseconds(8000));
+        REQUIRE(histogram.count() == 3);
+        REQUIRE(histogram.min() == microseconds(1000));
+        REQUIRE(histogram.max() == microseconds(8000));
+        REQUIRE(histogram.mean() == microseconds(4000));
+    }
+
+    SECTION("percentiles are within the bucket resolution") {
+        for (int i = 1; i <= 100; ++i) {
+            histogram.add(microseconds(i * 1000));
+        }
+        auto median = histogram.percentile(0.5).count();
+        REQUIRE(median >= 50000);
+        REQUIRE(median <= 50000 * 1.19 + 1);
+
+        auto p99 = histogram.percentile(0.99).count();
+        REQUIRE(p99 >= 99000);
+        REQUIRE(p99 <= 100000);
+
+        REQUIRE(histogram.percentile(1.0) == microseconds(100000));
+    }
+
+    SECTION("values land in the bucket they are under") {
+        for (std::size_t i = 0; i < 20; ++i) {
+            histogram.clear();
+            histogram.add(LatencyHistogram::bucketLimit(i));
+            REQUIRE(histogram.buckets()[i] == 1);
+        }
+    }
+
+    SECTION("out of range values are clamped") {
+        histogram.add(microseconds(-5));
+        histogram.add(microseconds(3600000000LL));
+        REQUIRE(histogram.buckets()[0] == 1);
+        REQUIRE(histogram.buckets()[LatencyHistogram::bucketCount - 1] == 1);
+        REQUIRE(histogram.min() == microseconds(0));
+    }
+}
@@ -0,0 +1,35 @@
+#include "catch2/catch.hpp"
+#include <vector>
+#include <psychic-ui/utils/Log.hpp>
+
+using namespace psychic_ui::log;
+
+TEST_CASE("logger hands messages to the sink in order", "[log]") {
+    Logger                   logger{};
+    std::vector<std::string> messages{};
+    std::vector<Level>       levels{};
+    logger.setSink(
+        [&messages, &levels](Level level, const std::string &message) {
+            levels.push_back(level);
+            messages.push_back(message);
+        }
+    );
+
+    SECTION("messages are written asynchronously and flushed") {
+        for (int i = 0; i < 100; ++i) {
+            logger.write(Level::Info, "message " + std::to_string(i));
+        }
+        logger.flush();
+        REQUIRE(messages.size() == 100);
+        REQUIRE(messages.front() == "message 0");
+        REQUIRE(messages.back() == "message 99");
+    }
+
+    SECTION("runtime level filters lower levels") {
+        logger.setLevel(Level::Warning);
+        REQUIRE_FALSE(logger.enabled(Level::Info));
+        REQUIRE(logger.enabled(Level::Warning));
+        REQUIRE(logger.enabled(Level::Error));
+        REQUIRE_FALSE(logger.enabled(Level::Off));
+    }
+}
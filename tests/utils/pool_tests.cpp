@@ -0,0 +1,81 @@
+#include "catch2/catch.hpp"
+#include <memory>
+#include <set>
+#include <psychic-ui/utils/Pool.hpp>
+#include <psychic-ui/utils/YogaNodePool.hpp>
+
+using namespace psychic_ui;
+
+namespace {
+    struct Node : public std::enable_shared_from_this<Node> {
+        explicit Node(int value) : value(value) {}
+        int    value;
+        double padding[3]{};
+    };
+}
+
+TEST_CASE("block pool", "[pool]") {
+
+    SECTION("blocks are recycled") {
+        BlockPool pool{24, 4};
+        REQUIRE(pool.blockSize() >= 24);
+        REQUIRE(pool.blockSize() % alignof(std::max_align_t) == 0);
+
+        std::set<void *> blocks{};
+        for (int i = 0; i < 10; ++i) {
+            blocks.insert(pool.allocate());
+        }
+        REQUIRE(blocks.size() == 10);
+        REQUIRE(pool.used() == 10);
+        REQUIRE(pool.capacity() == 12);
+        REQUIRE_FALSE(pool.trim());
+
+        void *first = *blocks.begin();
+        pool.deallocate(first);
+        REQUIRE(pool.allocate() == first);
+
+        for (auto block: blocks) {
+            pool.deallocate(block);
+        }
+        REQUIRE(pool.used() == 0);
+        REQUIRE(pool.trim());
+        REQUIRE(pool.capacity() == 0);
+    }
+
+    SECTION("pooled shared pointers") {
+        std::vector<std::shared_ptr<Node>> nodes{};
+        for (int i = 0; i < 1000; ++i) {
+            nodes.push_back(makePooled<Node>(i));
+        }
+        REQUIRE(nodes[500]->value == 500);
+        REQUIRE(nodes[500]->shared_from_this() == nodes[500]);
+        nodes.clear();
+    }
+}
+
+TEST_CASE("yoga node pool", "[pool]") {
+    YogaNodePool pool{4};
+
+    SECTION("detached leaves are recycled") {
+        YGNodeRef node = pool.acquire();
+        YGNodeStyleSetWidth(node, 10.0f);
+        pool.release(node);
+        REQUIRE(pool.available() == 1);
+        REQUIRE(pool.acquire() == node);
+        REQUIRE(YGNodeStyleGetWidth(node).unit != YGUnitPoint);
+        pool.release(node);
+    }
+
+    SECTION("attached nodes are freed") {
+        YGNodeRef parent = pool.acquire();
+        YGNodeRef child  = pool.acquire();
+        YGNodeInsertChild(parent, child, 0);
+
+        pool.release(child);
+        REQUIRE(pool.available() == 0);
+        REQUIRE(YGNodeGetChildCount(parent) == 0);
+
+        pool.release(parent);
+        REQUIRE(pool.available() == 1);
+    }
+}
@@ -0,0 +1,53 @@
+#include "catch2/catch.hpp"
+#include <sstream>
+#include <psychic-ui/utils/Profiler.hpp>
+
+using namespace psychic_ui::profiler;
+
+TEST_CASE("profiler records scopes and counters", "[profiler]") {
+    Profiler profiler{16};
+
+    SECTION("frames report their counters") {
+        profiler.beginFrame();
+        auto start = Clock::now();
+        profiler.record("style", start, start + std::chrono::microseconds(250));
+        profiler.count(Restyles, 3);
+        profiler.count(Measures);
+        profiler.endFrame();
+
+        auto events = profiler.events();
+        REQUIRE(events.size() == 2 + CounterCount);
+        REQUIRE(std::string(events[0].name) == "style");
+        REQUIRE(events[0].duration == 250);
+        REQUIRE(std::string(events[1].name) == "frame");
+        REQUIRE(events[2].type == Event::Value);
+        REQUIRE(std::string(events[2].name) == "restyles");
+        REQUIRE(events[2].duration == 3);
+        REQUIRE(events[3].duration == 1);
+        REQUIRE(profiler.frame() == 1);
+    }
+
+    SECTION("ring buffer keeps the most recent events") {
+        profiler.setCapacity(4);
+        const char *names[] = {"a", "b", "c", "d", "e", "f"};
+        for (const char *name: names) {
+            auto now = Clock::now();
+            profiler.record(name, now, now);
+        }
+
+        auto events = profiler.events();
+        REQUIRE(events.size() == 4);
+        REQUIRE(std::string(events.front().name) == "c");
+        REQUIRE(std::string(events.back().name) == "f");
+    }
+
+    SECTION("dumps chrome trace events") {
+        auto now = Clock::now();
+        profiler.record("render", now, now);
+
+        std::stringstream out{};
+        profiler.dump(out);
+        REQUIRE(out.str().find("\"traceEvents\"") != std::string::npos);
+        REQUIRE(out.str().find("\"name\":\"render\",\"cat\":\"psychic-ui\",\"ph\":\"X\"") != std::string::npos);
+    }
+}